@@ -0,0 +1,109 @@
+/****************************************
+  Line reader for serial commands.
+  See CommandLine.h for a description.
+*****************************************/
+
+#include "CommandLine.h"
+
+CommandLine::CommandLine()
+{
+  len = 0;
+  pos = 0;
+  ready = false;
+  over = false;
+}
+
+
+boolean CommandLine::poll()
+{
+  char c;
+
+  if (ready) {  // the last line has been handled, start a new one
+    ready = false;
+    over = false;
+    len = 0;
+  }
+
+  for (byte i = 0; i < CMD_SLICE && Serial.available(); i++) {
+    c = Serial.read();
+    if (c == '\r') continue;
+    if (c == '\n') {
+      if (len == 0 && !over) continue;  // ignore blank lines
+      line[len] = '\0';
+      pos = 0;
+      ready = true;
+      return true;
+    }
+    if (len < CMD_LINE_MAX) {
+      line[len++] = c;
+    } else {
+      over = true;
+    }
+  }
+  return false;
+}
+
+
+boolean CommandLine::overflow()
+{
+  return over;
+}
+
+
+const char *CommandLine::word()
+{
+  byte start;
+
+  while (pos < len && line[pos] == ' ') pos++;
+  start = pos;
+  while (pos < len && line[pos] != ' ') {
+    line[pos] = tolower(line[pos]);
+    pos++;
+  }
+  if (pos < len) line[pos++] = '\0';  // end the word, rest() starts after it
+  return line + start;
+}
+
+
+const char *CommandLine::rest()
+{
+  while (pos < len && line[pos] == ' ') pos++;
+  return line + pos;
+}
+
+
+int CommandLine::find(const char *w, const char *list)
+{
+  int index = 0;
+  byte i = 0;
+  char c;
+
+  if (!*w) return -1;
+  do {
+    c = pgm_read_byte(list++);
+    if (c == ' ' || c == '\0') {
+      if (i != 0xFF && w[i] == '\0') return index;
+      index++;
+      i = 0;
+    } else if (i != 0xFF && w[i] == c) {
+      i++;
+    } else {
+      i = 0xFF;  // mismatch, skip to the next entry
+    }
+  } while (c);
+  return -1;
+}
+
+
+boolean CommandLine::number(const char *w, int &val)
+{
+  long v = 0;
+
+  if (!*w) return false;
+  for (; *w; w++) {
+    if (*w < '0' || *w > '9' || v > 9999) return false;
+    v = v * 10 + (*w - '0');
+  }
+  val = v;
+  return true;
+}
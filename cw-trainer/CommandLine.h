@@ -0,0 +1,39 @@
+/****************************************
+  Line reader for serial commands.
+
+  poll() takes at most CMD_SLICE bytes from the serial port per call,
+  so it can sit in the Morse loops next to decode() without holding
+  them up; it returns true once a whole line has arrived. The line is
+  then taken apart with word(), which returns the words one after the
+  other in lower case, and rest(), which returns what is left as typed.
+  A line longer than CMD_LINE_MAX is read to its end and reported as
+  overflowed rather than cut short.
+*****************************************/
+
+#ifndef CommandLine_h
+#define CommandLine_h
+
+#include <Arduino.h>
+
+#define CMD_LINE_MAX 24   // "send " and a full group, with room to spare
+#define CMD_SLICE 4       // most bytes read by one poll()
+
+class CommandLine
+{
+  public:
+    CommandLine();
+    boolean poll();                  // true when a complete line is ready
+    boolean overflow();              // the ready line was too long
+    const char *word();              // next word, "" at the end of the line
+    const char *rest();              // the rest of the line, as typed
+    static int find(const char *w, const char *list);  // index of w in a PROGMEM "a b c" list, or -1
+    static boolean number(const char *w, int &val);     // w is a decimal number
+  private:
+    char line[CMD_LINE_MAX+1];
+    byte len;
+    byte pos;                        // parse position in a ready line
+    boolean ready;
+    boolean over;
+};
+
+#endif
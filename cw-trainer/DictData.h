@@ -0,0 +1,373 @@
+// Generated by tools/mkdict from the word lists in tools/mkdict. Do not edit.
+// Included once, by Dictionary.cpp.
+
+// dict_words: 578 entries, 3046 symbols
+const byte dict_words_blob[] PROGMEM = {
+  0x42, 0x35, 0x09, 0x95, 0x24, 0x04, 0xD3, 0x10, 0x4C, 0x0B, 0xD1, 0x04, 0xD2, 0x22, 0x54, 0x10,
+  0x01, 0x05, 0xD3, 0x34, 0x34, 0x01, 0x24, 0x04, 0x14, 0x01, 0x05, 0x12, 0x35, 0x40, 0x15, 0x45,
+  0x34, 0xD5, 0x44, 0x15, 0x13, 0x15, 0x48, 0x14, 0x31, 0x51, 0x81, 0x34, 0x48, 0x13, 0x25, 0x50,
+  0xD5, 0x20, 0x41, 0xD4, 0x10, 0x30, 0x4C, 0x31, 0x35, 0x01, 0xC3, 0x10, 0x4C, 0x30, 0x51, 0x45,
+  0x35, 0x55, 0x01, 0x43, 0x50, 0x01, 0xB3, 0x10, 0x50, 0xC5, 0x30, 0x02, 0xF5, 0x08, 0x8F, 0x34,
+  0x3C, 0x15, 0x25, 0x4C, 0x0F, 0xC1, 0x3C, 0xCF, 0x42, 0x34, 0xCF, 0x44, 0x0D, 0x4F, 0x25, 0x0D,
+  0xD4, 0xF3, 0x10, 0x01, 0x33, 0x3D, 0x04, 0xF4, 0x48, 0x14, 0x41, 0x3D, 0xCF, 0x42, 0x48, 0xCF,
+  0xD3, 0x10, 0x13, 0xF5, 0x40, 0x03, 0xF5, 0x40, 0xC2, 0xD3, 0x0C, 0x57, 0x30, 0x0D, 0xD4, 0xF5,
+  0x10, 0xD7, 0x23, 0x2D, 0x03, 0xF3, 0x5C, 0xC3, 0x14, 0x5C, 0xC4, 0x15, 0x30, 0xCB, 0x70, 0x05,
+  0x12, 0x31, 0x31, 0xCF, 0x45, 0x5C, 0x81, 0xD4, 0x14, 0x57, 0x40, 0x51, 0xD3, 0x00, 0x5D, 0x92,
+  0x90, 0x4C, 0x42, 0x42, 0x11, 0x57, 0xC2, 0x30, 0x43, 0x90, 0x48, 0xC5, 0x44, 0x25, 0x0C, 0x43,
+  0x30, 0xC9, 0x44, 0x11, 0x57, 0x90, 0x50, 0x04, 0x15, 0x24, 0x0C, 0xD1, 0x24, 0xD3, 0x24, 0x24,
+  0x8E, 0xF0, 0x38, 0x42, 0xE0, 0x08, 0xCE, 0x43, 0x2C, 0xCE, 0x73, 0x0D, 0xCE, 0x73, 0x0D, 0x4D,
+  0xE0, 0x10, 0x54, 0x25, 0x39, 0xC4, 0x15, 0x38, 0x94, 0x11, 0x38, 0x49, 0x13, 0x30, 0x05, 0xF4,
+  0x24, 0x0E, 0x35, 0x3C, 0x97, 0x53, 0x40, 0x4C, 0xE0, 0x50, 0xC3, 0x54, 0x39, 0x83, 0x54, 0x39,
+  0x45, 0xE5, 0x50, 0x09, 0x83, 0x34, 0x4F, 0xE5, 0x50, 0x41, 0xE2, 0x10, 0x4D, 0x90, 0x38, 0x05,
+  0xC4, 0x04, 0x89, 0x43, 0x4C, 0xCF, 0xE3, 0x10, 0x52, 0x90, 0x38, 0x44, 0xE5, 0x24, 0x14, 0x41,
+  0x3D, 0x97, 0x43, 0x40, 0x4C, 0xE0, 0x10, 0xCE, 0x53, 0x39, 0x44, 0xF3, 0x3C, 0xCE, 0x20, 0x05,
+  0x0E, 0x31, 0x39, 0xCF, 0x55, 0x40, 0x41, 0xE2, 0x50, 0x43, 0xE0, 0x50, 0x84, 0x52, 0x4D, 0xD4,
+  0x10, 0x48, 0xC5, 0xF0, 0x38, 0x05, 0x31, 0x3D, 0x4D, 0x21, 0x5C, 0x05, 0x71, 0x15, 0x52, 0x31,
+  0x54, 0x53, 0x41, 0x50, 0x49, 0x53, 0x14, 0x97, 0x94, 0x50, 0x05, 0xC1, 0x24, 0x4B, 0x41, 0x34,
+  0xC1, 0x52, 0x0C, 0x53, 0x51, 0x10, 0xCD, 0x23, 0x15, 0x06, 0x54, 0x3C, 0x10, 0x53, 0x14, 0x57,
+  0x40, 0x15, 0xD2, 0xE0, 0x14, 0x17, 0x41, 0x05, 0x4B, 0x61, 0x30, 0x09, 0x45, 0x31, 0x85, 0xD0,
+  0x14, 0x84, 0x13, 0x34, 0x05, 0xC1, 0x24, 0x4E, 0x41, 0x34, 0x45, 0xE0, 0x10, 0x53, 0xD0, 0x14,
+  0x04, 0x55, 0x30, 0xCC, 0x30, 0x15, 0x14, 0x71, 0x15, 0x0C, 0x53, 0x4C, 0x50, 0xC1, 0x30, 0x43,
+  0x53, 0x38, 0xC4, 0x55, 0x38, 0x14, 0xE1, 0x14, 0x81, 0x64, 0x04, 0xCE, 0x74, 0x15, 0x52, 0xC1,
+  0x14, 0x81, 0xE4, 0x14, 0x13, 0x15, 0x50, 0x05, 0xB1, 0x14, 0x05, 0x34, 0x30, 0x05, 0x45, 0x50,
+  0x52, 0x51, 0x0C, 0x53, 0x11, 0x10, 0x4C, 0x40, 0x15, 0x05, 0x24, 0x15, 0xD3, 0x44, 0x48, 0x45,
+  0xC0, 0x10, 0x0F, 0x54, 0x38, 0xC4, 0x54, 0x14, 0x0D, 0x51, 0x04, 0x53, 0x51, 0x40, 0x01, 0x54,
+  0x48, 0x06, 0x53, 0x50, 0x54, 0x21, 0x11, 0x4D, 0xC2, 0x14, 0x43, 0x11, 0x50, 0xC4, 0x54, 0x49,
+  0x05, 0x01, 0x3D, 0x53, 0x71, 0x34, 0x45, 0x30, 0x55, 0x52, 0x71, 0x38, 0x55, 0x53, 0x48, 0x01,
+  0x43, 0x04, 0x52, 0x11, 0x10, 0x8B, 0x53, 0x5C, 0x04, 0x25, 0x55, 0x05, 0x31, 0x51, 0x05, 0x44,
+  0x5C, 0xC5, 0x44, 0x21, 0x89, 0x43, 0x15, 0x52, 0x31, 0x51, 0x06, 0x93, 0x4C, 0x54, 0xE1, 0x10,
+  0x4C, 0x31, 0x4D, 0x03, 0x55, 0x38, 0xC6, 0x94, 0x34, 0x10, 0x53, 0x1C, 0x50, 0x40, 0x51, 0x85,
+  0xE4, 0x18, 0x50, 0x21, 0x4D, 0x8F, 0x63, 0x04, 0x10, 0x54, 0x04, 0x12, 0x21, 0x55, 0x4C, 0x51,
+  0x40, 0xCF, 0x55, 0x48, 0x84, 0xF3, 0x50, 0x05, 0x21, 0x15, 0x13, 0x45, 0x5C, 0x45, 0xB1, 0x18,
+  0x4D, 0xE2, 0x54, 0x54, 0x61, 0x4C, 0x94, 0x54, 0x14, 0x14, 0x41, 0x15, 0x13, 0x55, 0x40, 0x4C,
+  0xE0, 0x14, 0x04, 0x95, 0x48, 0x05, 0x51, 0x04, 0x13, 0x75, 0x04, 0x0E, 0x55, 0x38, 0x4E, 0x50,
+  0x50, 0xCF, 0x55, 0x48, 0x83, 0x53, 0x50, 0x45, 0xF3, 0x48, 0x53, 0x41, 0x50, 0x8F, 0x53, 0x18,
+  0x52, 0x01, 0x3D, 0x12, 0x25, 0x14, 0xD3, 0x00, 0x4D, 0x85, 0xF0, 0x18, 0x83, 0xF1, 0x48, 0x84,
+  0x21, 0x3D, 0x8D, 0x90, 0x18, 0x85, 0x91, 0x48, 0x13, 0x55, 0x04, 0x06, 0x55, 0x48, 0x84, 0xF1,
+  0x48, 0x8D, 0x61, 0x3C, 0x0C, 0xF3, 0x5C, 0xC3, 0x63, 0x18, 0xC4, 0x54, 0x30, 0x06, 0x61, 0x3C,
+  0x95, 0x44, 0x18, 0x81, 0xD4, 0x0C, 0x46, 0x20, 0x11, 0x4C, 0x61, 0x50, 0x04, 0x93, 0x18, 0xC5,
+  0x60, 0x14, 0x57, 0xF1, 0x18, 0x54, 0xE1, 0x10, 0x46, 0x51, 0x50, 0x84, 0x51, 0x14, 0x0C, 0x61,
+  0x24, 0x52, 0x41, 0x18, 0xC1, 0x44, 0x11, 0x46, 0xE2, 0x14, 0x84, 0x11, 0x30, 0x4C, 0x61, 0x48,
+  0x8F, 0x43, 0x15, 0x46, 0xE2, 0x04, 0x0C, 0x61, 0x48, 0x45, 0x41, 0x18, 0x15, 0xC3, 0x10, 0xC6,
+  0xF3, 0x50, 0x84, 0x91, 0x30, 0x0C, 0x61, 0x24, 0x13, 0x35, 0x64, 0x4F, 0x45, 0x64, 0x4F, 0x25,
+  0x0D, 0x57, 0x90, 0x11, 0x4D, 0xE0, 0x64, 0x42, 0x93, 0x0D, 0x4D, 0x90, 0x0D, 0x81, 0x93, 0x11,
+  0x8F, 0xC3, 0x64, 0x44, 0x56, 0x04, 0xD2, 0x30, 0x05, 0x19, 0x01, 0x31, 0x41, 0x36, 0x50, 0x52,
+  0x36, 0x14, 0x59, 0x51, 0x4C, 0xD4, 0x23, 0x65, 0x46, 0xC0, 0x5C, 0x41, 0x36, 0x19, 0x46, 0xD0,
+  0x24, 0x4C, 0x56, 0x14, 0x81, 0xC4, 0x64, 0x03, 0x13, 0x64, 0x45, 0xF3, 0x38, 0x45, 0x36, 0x18,
+  0x4C, 0x86, 0x34, 0x15, 0x43, 0x25, 0x10, 0x93, 0x11, 0x13, 0x15, 0x64, 0xC6, 0x94, 0x4D, 0x54,
+  0xD1, 0x0C, 0x59, 0x31, 0x0D, 0x4B, 0x91, 0x09, 0x19, 0x43, 0x3C, 0x56, 0x21, 0x11, 0x4C, 0x62,
+  0x15, 0x45, 0x61, 0x15, 0x52, 0x46, 0x58, 0x85, 0x94, 0x11, 0xCD, 0x63, 0x15, 0x44, 0x61, 0x15,
+  0x4E, 0xE1, 0x14, 0x56, 0x21, 0x15, 0x52, 0x62, 0x15, 0x12, 0x51, 0x58, 0x85, 0x54, 0x30, 0x45,
+  0x60, 0x15, 0x84, 0x91, 0x58, 0x85, 0x41, 0x49, 0x81, 0x55, 0x30, 0xC7, 0x54, 0x58, 0x85, 0x14,
+  0x30, 0x85, 0xF5, 0x5C, 0x05, 0x43, 0x30, 0x8F, 0x55, 0x14, 0x53, 0x21, 0x59, 0x05, 0xC1, 0x3C,
+  0xCE, 0x21, 0x1C, 0xCF, 0x70, 0x14, 0x14, 0x71, 0x24, 0x56, 0x51, 0x1C, 0x52, 0x11, 0x50, 0x05,
+  0x13, 0x48, 0x47, 0x51, 0x04, 0x47, 0x90, 0x38, 0x04, 0x14, 0x1C, 0x05, 0x71, 0x48, 0xCF, 0x35,
+  0x1C, 0x0F, 0x55, 0x1C, 0xD2, 0x53, 0x41, 0xC4, 0x91, 0x48, 0x4C, 0x91, 0x3D, 0x95, 0x73, 0x10,
+  0xD3, 0xE3, 0x1C, 0xC4, 0x92, 0x38, 0x07, 0x31, 0x25, 0xCE, 0x71, 0x34, 0x8F, 0xE4, 0x24, 0xCE,
+  0x71, 0x04, 0x47, 0x90, 0x38, 0x13, 0x65, 0x1C, 0x8F, 0x55, 0x48, 0x8E, 0x61, 0x24, 0x47, 0x25,
+  0x15, 0xC4, 0x11, 0x58, 0x45, 0x71, 0x48, 0x45, 0xE1, 0x18, 0x13, 0x25, 0x3D, 0xCE, 0x31, 0x04,
+  0xC7, 0x43, 0x1C, 0x41, 0x53, 0x20, 0x4C, 0xE0, 0x1C, 0x55, 0x70, 0x14, 0x45, 0xD0, 0x3C, 0xCE,
+  0x61, 0x4C, 0xC9, 0xE1, 0x04, 0x0C, 0x91, 0x05, 0x47, 0x32, 0x48, 0xC9, 0x31, 0x30, 0xCF, 0x21,
+  0x1C, 0x8D, 0x70, 0x04, 0xC2, 0x51, 0x08, 0x87, 0x33, 0x04, 0x87, 0x33, 0x80, 0x8E, 0x23, 0x80,
+  0x17, 0x12, 0x55, 0xC5, 0x44, 0x25, 0x8F, 0x63, 0x14, 0x51, 0x15, 0x50, 0xC5, 0x10, 0x4D, 0xCC,
+  0x10, 0x49, 0xCC, 0x10, 0x49, 0xCD, 0x10, 0x49, 0xCE, 0x10, 0x49, 0xD3, 0x10, 0x49, 0xD1, 0x10,
+  0x4D, 0xD9, 0x10, 0x49, 0xD5, 0x10, 0x49, 0xD6, 0x00, 0x92, 0xE4, 0x00, 0x82, 0xE4, 0x10, 0x49,
+  0xDA, 0x40, 0x21, 0x05, 0x41, 0x21, 0x01, 0x25, 0x20, 0x05, 0x71, 0x25, 0x14, 0x32, 0x20, 0xC9,
+  0x44, 0x50, 0x48, 0x91, 0x11, 0x48, 0x60, 0x15, 0x04, 0x85, 0x24, 0xD3, 0x80, 0x3C, 0x14, 0x71,
+  0x21, 0x01, 0x55, 0x3C, 0x14, 0x52, 0x48, 0x05, 0x85, 0x14, 0x52, 0x41, 0x5C, 0x48, 0xE1, 0x0C,
+  0xC8, 0x73, 0x0D, 0x13, 0x52, 0x14, 0x14, 0x52, 0x24, 0x12, 0x41, 0x21, 0x85, 0x43, 0x50, 0x48,
+  0xD1, 0x14, 0x14, 0x52, 0x4C, 0xC5, 0x80, 0x14, 0x52, 0x41, 0x21, 0x89, 0x73, 0x0C, 0x48, 0xD2,
+  0x0C, 0x48, 0x30, 0x11, 0x14, 0x12, 0x38, 0xC3, 0x85, 0x3C, 0xC5, 0x85, 0x14, 0x52, 0x41, 0x4C,
+  0xC8, 0x73, 0x1D, 0x14, 0x22, 0x3D, 0xD5, 0x81, 0x14, 0x14, 0x92, 0x38, 0x0B, 0x81, 0x14, 0x0C,
+  0x54, 0x48, 0xC9, 0x81, 0x50, 0x05, 0x85, 0x48, 0x45, 0x41, 0x20, 0x4F, 0x53, 0x10, 0x48, 0x21,
+  0x15, 0x04, 0x92, 0x1C, 0xC8, 0x70, 0x21, 0x59, 0xC1, 0x24, 0x07, 0x42, 0x15, 0xC8, 0x53, 0x4D,
+  0x85, 0xD1, 0x3C, 0x14, 0x52, 0x48, 0x45, 0x11, 0x48, 0x14, 0x62, 0x18, 0x01, 0x85, 0x14, 0xD2,
+  0x41, 0x21, 0x4F, 0x75, 0x20, 0x54, 0xD1, 0x24, 0x07, 0x42, 0x15, 0x17, 0x92, 0x30, 0x45, 0xE1,
+  0x24, 0x07, 0x42, 0x15, 0xCE, 0x23, 0x51, 0x08, 0x42, 0x3D, 0x47, 0x41, 0x21, 0x85, 0x54, 0x5C,
+  0x48, 0x42, 0x15, 0x05, 0x85, 0x3C, 0x53, 0x41, 0x18, 0xC9, 0x84, 0x10, 0x48, 0x11, 0x48, 0x05,
+  0xF2, 0x48, 0x53, 0x61, 0x14, 0xCE, 0x53, 0x1D, 0x88, 0x41, 0x21, 0x4F, 0x75, 0x20, 0xC5, 0x84,
+  0x3C, 0x12, 0x65, 0x20, 0x01, 0x04, 0x15, 0x0E, 0x31, 0x21, 0x09, 0x44, 0x20, 0x01, 0x63, 0x14,
+  0xD3, 0x53, 0x51, 0x48, 0x71, 0x21, 0x0F, 0x53, 0x10, 0xC8, 0x53, 0x49, 0xC2, 0x83, 0x1C, 0xCE,
+  0x43, 0x21, 0x89, 0x73, 0x14, 0x17, 0x52, 0x14, 0x4C, 0xC1, 0x04, 0xD5, 0x81, 0x14, 0x13, 0x12,
+  0x40, 0x05, 0x81, 0x14, 0x01, 0x75, 0x5C, 0x45, 0x40, 0x21, 0x85, 0x34, 0x44, 0x14, 0x22, 0x20,
+  0x92, 0x80, 0x5C, 0x03, 0x02, 0x15, 0xC2, 0x38, 0x0E, 0xE3, 0xD6, 0x08, 0x42, 0x21, 0x08, 0xD9,
+  0x20, 0x54, 0x54, 0x11, 0x08, 0x4F, 0x45, 0x19, 0x4E, 0xD5, 0x08, 0x85, 0x44, 0x08, 0x45, 0xE1,
+  0x18, 0x42, 0x61, 0x3C, 0x52, 0x31, 0x08, 0x4F, 0x36, 0x08, 0xC9, 0x71, 0x08, 0x05, 0x75, 0x15,
+  0x85, 0x53, 0x08, 0xC5, 0x91, 0x38, 0x84, 0xF0, 0x50, 0x08, 0x21, 0x3C, 0xCF, 0x52, 0x08, 0xC5,
+  0x11, 0x38, 0x84, 0x10, 0x4C, 0x45, 0x11, 0x08, 0x8F, 0x55, 0x1C, 0x90, 0xF4, 0x08, 0x4C, 0xD1,
+  0x10, 0x42, 0x31, 0x51, 0x86, 0x50, 0x50, 0x54, 0x21, 0x21, 0x52, 0xD1, 0x14, 0x8D, 0x50, 0x48,
+  0x84, 0x55, 0x48, 0x42, 0x41, 0x05, 0x02, 0x53, 0x10, 0x81, 0xC0, 0x14, 0x86, 0x50, 0x04, 0x15,
+  0x95, 0x11, 0x02, 0x53, 0x15, 0x84, 0x50, 0x4D, 0x19, 0x21, 0x3C, 0x01, 0x85, 0x40, 0xCF, 0x34,
+  0x25, 0x02, 0x53, 0x1C, 0x82, 0xF4, 0x54, 0x07, 0x42, 0x15, 0x82, 0x94, 0x38, 0x87, 0x60, 0x08,
+  0x43, 0x20, 0x50, 0x43, 0x34, 0x09, 0xC3, 0xB7, 0x35, 0x43, 0xB7, 0x35, 0x82, 0xE8, 0x0D, 0xA0,
+  0x48, 0x0E, 0x43, 0xE0, 0x10, 0x45, 0x30, 0x20, 0xC5, 0x85, 0x24, 0x03, 0x42, 0x0C, 0x4F, 0x53,
+  0x10, 0x43, 0xC0, 0x30, 0x05, 0xC4, 0x04, 0x43, 0x41, 0x08, 0xC1, 0xB0, 0x10, 0x43, 0xD0, 0x14,
+  0xC8, 0x54, 0x38, 0x54, 0xE1, 0x0C, 0x45, 0x31, 0x04, 0xD5, 0x54, 0x10, 0x4D, 0x35, 0x20, 0xC4,
+  0x54, 0x0D, 0xC8, 0x10, 0x0C, 0x94, 0x31, 0x20, 0x81, 0x73, 0x14, 0x07, 0x94, 0x0C, 0x54, 0x25,
+  0x15, 0xC7, 0xF0, 0x54, 0x0E, 0x25, 0x65, 0xC6, 0x34, 0x20, 0xCF, 0xC3, 0x14, 0xC3, 0x63, 0x15,
+  0x12, 0x31, 0x24, 0x54, 0x56, 0x0C, 0xD2, 0x33, 0x4D, 0xC5, 0xC0, 0x3C, 0x53, 0x51, 0x34, 0xD5,
+  0x94, 0x0C, 0xC3, 0x10, 0x48, 0xC4, 0x10, 0x48, 0x45, 0x31, 0x04, 0x92, 0x94, 0x1D, 0xD3, 0x90,
+  0x14, 0xCE, 0x50, 0x10, 0x8F, 0x33, 0x14, 0xC3, 0x50, 0x51, 0xC5, 0x15, 0x50, 0x03, 0x52, 0x0C,
+  0x0F, 0xF3, 0x48, 0x84, 0x11, 0x0C, 0x45, 0x21, 0x30, 0xC1, 0xB0, 0x14, 0x03, 0x13, 0x4C, 0x13,
+  0x32, 0x3C, 0x0D, 0xC4, 0x14, 0x54, 0x41, 0x48, 0xCF, 0xB0, 0x14, 0x50, 0x52, 0x0C, 0x45, 0x31,
+  0x25, 0xCE, 0x50, 0x14, 0x13, 0x14, 0x0C, 0x45, 0x21, 0x15, 0xC1, 0x80, 0x18, 0x43, 0xE1, 0x50,
+  0x85, 0x64, 0x38, 0x0F, 0x95, 0x0C, 0x45, 0x61, 0x3D, 0xC9, 0x50, 0x1C, 0x43, 0x21, 0x51, 0x41,
+  0xE2, 0x0C, 0x83, 0x94, 0x1D, 0x4D, 0x30, 0x20, 0x89, 0x53, 0x1C, 0xC3, 0x23, 0x49, 0xC5, 0x40,
+  0x1D, 0xC3, 0xE3, 0x50, 0x41, 0xE2, 0x14, 0x54, 0x11, 0x0C, 0x48, 0x11, 0x55, 0xC9, 0xB0, 0x14,
+  0xCF, 0x50, 0x04, 0xCE, 0x31, 0x41, 0xC5, 0x90, 0x04, 0x4C, 0x31, 0x30, 0x45, 0x20, 0x11, 0x46,
+  0x30, 0x50, 0x44, 0xE2, 0x0C, 0x88, 0x31, 0x3C, 0x95, 0x34, 0x15, 0x85, 0xF1, 0x48, 0x43, 0x61,
+  0x3C, 0x82, 0x52, 0x0C, 0xD4, 0x31, 0x55, 0x92, 0x11, 0x0C, 0x85, 0x31, 0x3C, 0x4D, 0xF3, 0x38,
+  0xC5, 0x80, 0x14, 0xC3, 0x72, 0x0C, 0x8F, 0x43, 0x15, 0x13, 0x45, 0x0C, 0x0F, 0x94, 0x0D, 0x43,
+  0xC5, 0x10, 0xD2, 0x60, 0x49, 0xC2, 0x10, 0x11, 0xDC, 0xB6, 0x5D, 0x03, 0xB7, 0x5C, 0x03, 0x07,
+  0x36, 0x03, 0xB7, 0x35, 0x43, 0xE0, 0x10, 0x03, 0x12, 0x10, 0xC4, 0xF5, 0x48, 0x04, 0x31, 0x05,
+  0x09, 0x21, 0x10, 0x4F, 0x71, 0x3D, 0x15, 0x43, 0x0C, 0x44, 0x90, 0x15, 0xC3, 0x53, 0x31, 0xC4,
+  0x40, 0x24, 0x44, 0x31, 0x3D, 0x95, 0x43, 0x10, 0xC4, 0x73, 0x39, 0xC4, 0x94, 0x10, 0x05, 0x61,
+  0x24, 0x0E, 0x41, 0x34, 0x01, 0x51, 0x14, 0xD2, 0x53, 0x39, 0x04, 0x71, 0x3C, 0x0F, 0x51, 0x54,
+  0x0E, 0x51, 0x48, 0x06, 0x91, 0x18, 0x46, 0x21, 0x0D, 0x0F, 0x43, 0x10, 0xC4, 0x53, 0x4C, 0x43,
+  0xE1, 0x10, 0x84, 0x54, 0x04, 0x04, 0x81, 0x04, 0x0E, 0x31, 0x04, 0x04, 0x41, 0x30, 0x81, 0x43,
+  0x10, 0x4B, 0xE2, 0x10, 0x84, 0x53, 0x14, 0x44, 0x71, 0x3D, 0x12, 0x43, 0x14, 0x42, 0x95, 0x30,
+  0x04, 0x81, 0x14, 0x01, 0x51, 0x4C, 0x54, 0xE0, 0x10, 0xC6, 0x84, 0x3C, 0x15, 0x43, 0x14, 0xC6,
+  0x53, 0x39, 0x44, 0x31, 0x51, 0x15, 0x91, 0x11, 0xC6, 0xF3, 0x10, 0x04, 0x12, 0x48, 0x04, 0x41,
+  0x48, 0xC1, 0x85, 0x0C, 0x48, 0xC2, 0x10, 0x52, 0xE1, 0x18, 0x53, 0x31, 0x3C, 0x0E, 0x61, 0x18,
+  0x52, 0x52, 0x38, 0x04, 0x91, 0x10, 0x45, 0x40, 0x5C, 0xCF, 0x43, 0x14, 0x52, 0x11, 0x10, 0xD9,
+  0x20, 0x15, 0x04, 0x21, 0x24, 0x12, 0x41, 0x08, 0x0F, 0x91, 0x0D, 0xC4, 0x73, 0x18, 0x44, 0x22,
+  0x15, 0x03, 0x45, 0x10, 0xCF, 0x23, 0x1D, 0x90, 0xF4, 0x10, 0xD5, 0x40, 0x11, 0x57, 0xE2, 0x10,
+  0xC5, 0x23, 0x11, 0x85, 0x44, 0x50, 0x0F, 0x43, 0x14, 0x48, 0x11, 0x48, 0x84, 0x41, 0x54, 0x52,
+  0xE2, 0x1C, 0x07, 0x52, 0x39, 0x84, 0x54, 0x10, 0x04, 0xF2, 0x30, 0x84, 0x71, 0x48, 0x4F, 0xE5,
+  0x10, 0x06, 0xF5, 0x5C, 0x81, 0x44, 0x10, 0xD2, 0x13, 0x10, 0xC4, 0xF0, 0x30, 0x04, 0xC1, 0x14,
+  0x01, 0x41, 0x10, 0x81, 0xB4, 0x14, 0x46, 0x52, 0x30, 0x44, 0x01, 0x3D, 0x95, 0x43, 0x10, 0xC4,
+  0xE3, 0x14, 0x05, 0x21, 0x25, 0x56, 0x51, 0x4C, 0xD4, 0xF3, 0x10, 0x07, 0x51, 0x58, 0x05, 0xF3,
+  0x40, 0x44, 0x93, 0x38, 0x84, 0x21, 0x14, 0x48, 0xE2, 0x10, 0x07, 0x24, 0x3D, 0x44, 0x35, 0x14,
+  0x06, 0x51, 0x0C, 0x09, 0x51, 0x10, 0x44, 0x51, 0x40, 0x46, 0x32, 0x31, 0x81, 0x43, 0x18, 0x52,
+  0x31, 0x3C, 0x12, 0x41, 0x1C, 0x0F, 0x43, 0x14, 0x13, 0x55, 0x04, 0xC4, 0x40, 0x48, 0x99, 0x71,
+  0x3D, 0x0E, 0x51, 0x48, 0x08, 0x85, 0x3C, 0xD5, 0x14, 0x38, 0xC4, 0x41, 0x24, 0x13, 0x15, 0x38,
+  0x54, 0x21, 0x05, 0x44, 0xF2, 0x18, 0x50, 0x40, 0x10, 0x4C, 0x41, 0x08, 0x81, 0x43, 0x18, 0x44,
+  0x02, 0x3D, 0x4C, 0x41, 0x4C, 0x4B, 0x41, 0x10, 0x43, 0x20, 0x11, 0x03, 0x91, 0x50, 0x03, 0x11,
+  0x20, 0xC4, 0xF0, 0x10, 0x85, 0x40, 0x14, 0x04, 0x17, 0x6E, 0x0D, 0xE1, 0x14, 0x18, 0x75, 0x14,
+  0x58, 0xD0, 0x40, 0x4C, 0x31, 0x4C, 0x09, 0x36, 0x08, 0x0F, 0x46, 0x0C, 0x4F, 0x80, 0x0D, 0x58,
+  0xC6, 0x0C, 0x94, 0x83, 0x09, 0x17, 0x46, 0x60, 0x0D, 0x25, 0x09, 0x04, 0x06, 0x00,
+};
+const uint16_t dict_words_index[] PROGMEM = {
+  0, 65, 136, 209, 275, 361, 435, 517, 599, 687,
+  786, 866, 947, 1023, 1111, 1196, 1279, 1378, 1445, 1513,
+  1592, 1685, 1786, 1867, 1949, 2048, 2127, 2223, 2319, 2425,
+  2501, 2584, 2670, 2763, 2860, 2963, 3038,
+};
+const uint16_t dict_words_koch[] PROGMEM = {
+  0, 0, 0, 0, 0, 2, 5, 8, 17, 23,
+  38, 49, 58, 58, 88, 89, 171, 201, 201, 227,
+  243, 243, 279, 281, 281, 292, 294, 295, 367, 367,
+  369, 402, 402, 403, 404, 406, 471, 475, 567, 568,
+  578,
+};
+const Dictionary dict_words PROGMEM = {dict_words_blob, dict_words_index, dict_words_koch, 578};
+
+// dict_calls: 400 entries, 2549 symbols
+const byte dict_calls_blob[] PROGMEM = {
+  0x45, 0x10, 0x6C, 0x8C, 0x53, 0x04, 0xCA, 0x36, 0x51, 0xC4, 0xB2, 0x25, 0x54, 0xB1, 0x14, 0x5B,
+  0x65, 0x18, 0x8B, 0xB1, 0x51, 0xD5, 0x45, 0x2C, 0xCD, 0x76, 0x19, 0x4C, 0xB0, 0x19, 0x41, 0x50,
+  0x30, 0xC1, 0x46, 0x41, 0xC6, 0x15, 0x6C, 0x53, 0x52, 0x11, 0xCD, 0xD6, 0x64, 0x06, 0x94, 0x6D,
+  0x8C, 0xE4, 0x10, 0x50, 0xB6, 0x59, 0x84, 0xB5, 0x6C, 0x4E, 0x71, 0x5C, 0x5B, 0xC1, 0x10, 0xC1,
+  0x02, 0x1A, 0x85, 0x01, 0x42, 0x97, 0x35, 0x1C, 0x60, 0x40, 0x1C, 0xA0, 0xD4, 0x10, 0x09, 0x38,
+  0x51, 0xC6, 0x12, 0x80, 0x4C, 0x12, 0x18, 0x4B, 0x01, 0x06, 0xD7, 0x61, 0x2C, 0x0A, 0x68, 0x58,
+  0x86, 0xB1, 0x34, 0x60, 0x76, 0x35, 0xC5, 0x53, 0x80, 0x56, 0x41, 0x4C, 0x0D, 0x78, 0x14, 0x56,
+  0x00, 0x4E, 0x92, 0x61, 0x2D, 0xA0, 0x61, 0x3C, 0xC8, 0xE2, 0x6C, 0x97, 0x22, 0x9D, 0x90, 0x11,
+  0x04, 0x60, 0xB2, 0x44, 0x44, 0x50, 0x6C, 0x91, 0x51, 0x04, 0xDB, 0x15, 0x4D, 0x45, 0x50, 0x90,
+  0x8D, 0x54, 0x04, 0x09, 0xF9, 0x04, 0x46, 0x91, 0x90, 0xCB, 0x52, 0x15, 0x45, 0x42, 0x3E, 0xD0,
+  0x60, 0x90, 0xCC, 0x91, 0x90, 0xC9, 0x12, 0x9D, 0xD0, 0x90, 0x90, 0x55, 0x91, 0x90, 0x99, 0x52,
+  0x15, 0x4A, 0x40, 0x16, 0x97, 0xA1, 0x04, 0x64, 0x33, 0x55, 0xC5, 0x42, 0x66, 0x53, 0xA1, 0x2C,
+  0x05, 0x59, 0x50, 0xD5, 0x19, 0x49, 0x90, 0xB1, 0x18, 0xA4, 0xF5, 0x2C, 0x05, 0x13, 0x90, 0xCD,
+  0x31, 0x34, 0xE4, 0x53, 0x3C, 0x0B, 0x39, 0x2D, 0xCA, 0xD4, 0x90, 0x52, 0x70, 0x9C, 0x91, 0x04,
+  0x11, 0x13, 0x44, 0x32, 0x84, 0xB5, 0x90, 0x4C, 0x71, 0x91, 0x51, 0xF2, 0x18, 0x59, 0x45, 0x06,
+  0x8D, 0x65, 0x04, 0xC7, 0x46, 0x2D, 0x5A, 0x11, 0x1C, 0x9B, 0xA6, 0x10, 0x8F, 0x06, 0x26, 0xC4,
+  0xA3, 0x81, 0x13, 0xA1, 0x31, 0x9B, 0x53, 0x68, 0xCC, 0x36, 0x25, 0x46, 0x91, 0x80, 0x0E, 0xB2,
+  0x14, 0xC6, 0x96, 0x25, 0x48, 0x71, 0x34, 0x24, 0x02, 0x15, 0xC7, 0xB5, 0x21, 0x4D, 0xA1, 0x20,
+  0x60, 0xE5, 0x10, 0x0A, 0x42, 0x16, 0x85, 0x43, 0x06, 0x08, 0x65, 0x3C, 0x08, 0x68, 0x29, 0x54,
+  0xF1, 0x20, 0xA4, 0x34, 0x15, 0xCF, 0x02, 0x22, 0x8D, 0x11, 0x04, 0x9E, 0x41, 0x39, 0x45, 0xB0,
+  0x78, 0xC5, 0x54, 0x18, 0x1E, 0xA2, 0x31, 0xC5, 0xD1, 0x78, 0xCB, 0x61, 0x28, 0x81, 0x57, 0x40,
+  0x0E, 0xB2, 0x14, 0x9E, 0x65, 0x49, 0x27, 0x64, 0x2C, 0x87, 0x77, 0x41, 0x59, 0xB1, 0x34, 0x5E,
+  0x46, 0x15, 0x8B, 0xE3, 0x19, 0x01, 0xC1, 0x54, 0x5E, 0x55, 0x3C, 0x85, 0x17, 0x21, 0xC6, 0x83,
+  0x78, 0x92, 0x43, 0x15, 0x50, 0xE6, 0x35, 0x95, 0x31, 0x35, 0xDE, 0x23, 0x3D, 0x85, 0x55, 0x78,
+  0x08, 0x65, 0x64, 0x95, 0x77, 0x35, 0x57, 0xA1, 0x31, 0x9E, 0x63, 0x18, 0x1A, 0xE3, 0x59, 0x54,
+  0x53, 0x68, 0x93, 0x57, 0x45, 0x45, 0x10, 0x8C, 0xC6, 0x54, 0x04, 0xC5, 0xD8, 0x38, 0x46, 0x70,
+  0x8C, 0x0A, 0xE3, 0x14, 0xC1, 0x32, 0x66, 0xCD, 0x51, 0x24, 0x63, 0x75, 0x9D, 0x10, 0x71, 0x34,
+  0x63, 0xA4, 0x1C, 0xD7, 0x78, 0x3D, 0xCF, 0x19, 0x49, 0x50, 0xB1, 0x1C, 0xE3, 0x03, 0x15, 0x4B,
+  0x32, 0x52, 0x0B, 0xB1, 0x38, 0xE3, 0x61, 0x2C, 0xCE, 0x38, 0x05, 0x4F, 0xB1, 0x3C, 0x63, 0x85,
+  0x0C, 0xCE, 0x58, 0x0C, 0xCE, 0xA8, 0x11, 0x53, 0x33, 0x36, 0xC4, 0xD4, 0x8C, 0x8E, 0x61, 0x05,
+  0x63, 0xC5, 0x44, 0x86, 0x15, 0x8C, 0x9A, 0x72, 0x11, 0xDA, 0x34, 0x3A, 0x46, 0x20, 0x6C, 0xC8,
+  0x64, 0x24, 0x81, 0xB0, 0x45, 0xCA, 0x19, 0x49, 0x90, 0x11, 0x08, 0x24, 0x43, 0x39, 0x46, 0x60,
+  0x90, 0x82, 0xA6, 0x15, 0x45, 0x40, 0x0A, 0x47, 0x71, 0x34, 0x9E, 0x30, 0x19, 0x47, 0x43, 0x3E,
+  0x86, 0x50, 0x24, 0xA0, 0x70, 0x14, 0xC5, 0x22, 0x6C, 0x53, 0x52, 0x2C, 0xC2, 0xA6, 0x69, 0xC6,
+  0x22, 0x78, 0x91, 0xC3, 0x10, 0x8F, 0x43, 0x0A, 0x46, 0x15, 0x8C, 0x91, 0xD0, 0x18, 0x56, 0x40,
+  0x36, 0x8E, 0x50, 0x64, 0xD5, 0x28, 0x18, 0x49, 0x10, 0x7C, 0x57, 0x76, 0x46, 0x12, 0x64, 0x04,
+  0xC7, 0xA7, 0x49, 0x8D, 0x11, 0x24, 0x1F, 0xC2, 0x1C, 0x45, 0x90, 0x7C, 0x4F, 0x44, 0x1C, 0x1F,
+  0x12, 0x14, 0xC7, 0xD7, 0x20, 0x8E, 0x71, 0x5C, 0x5F, 0x10, 0x48, 0xC5, 0xF2, 0x2D, 0x0A, 0x53,
+  0x2C, 0xDF, 0x35, 0x5D, 0xC6, 0x12, 0x7C, 0x42, 0xD4, 0x18, 0xCB, 0xF1, 0x41, 0xD0, 0x63, 0x2C,
+  0xC7, 0x37, 0x19, 0x46, 0xB1, 0x38, 0x9F, 0x92, 0x11, 0x4C, 0xF0, 0x15, 0x05, 0x13, 0x7C, 0x5A,
+  0x64, 0x3C, 0xCB, 0x27, 0x45, 0x90, 0x51, 0x05, 0x5F, 0xA0, 0x14, 0x45, 0x15, 0x7C, 0x13, 0x45,
+  0x5C, 0xC1, 0x77, 0x14, 0x57, 0xF0, 0x1D, 0x05, 0x91, 0x55, 0x5F, 0x64, 0x68, 0xCC, 0xC7, 0x34,
+  0x47, 0x11, 0x14, 0xDD, 0x24, 0x15, 0xC1, 0xD1, 0x69, 0x55, 0x11, 0x28, 0x9D, 0xA3, 0x18, 0x81,
+  0xD2, 0x59, 0x59, 0x56, 0x14, 0x41, 0x97, 0x38, 0x45, 0x11, 0x74, 0x96, 0x56, 0x1C, 0x1D, 0x14,
+  0x21, 0xC4, 0xD1, 0x74, 0x12, 0x71, 0x5C, 0x9D, 0x41, 0x20, 0x42, 0x47, 0x15, 0x4A, 0xD0, 0x1D,
+  0x13, 0xB1, 0x08, 0x9D, 0x64, 0x2C, 0x45, 0x17, 0x3C, 0x46, 0xB2, 0x14, 0x5D, 0x02, 0x9D, 0x91,
+  0x04, 0x19, 0x8B, 0xD1, 0x45, 0xD4, 0x63, 0x2C, 0x4F, 0x07, 0x25, 0x93, 0xC1, 0x04, 0x5D, 0x25,
+  0x5C, 0x44, 0xD3, 0x2D, 0x53, 0xD1, 0x74, 0x8D, 0x25, 0x11, 0x4E, 0x67, 0x4C, 0x06, 0x14, 0x74,
+  0x50, 0xF2, 0x14, 0x50, 0xD6, 0x19, 0x4C, 0x31, 0x35, 0x5D, 0xA3, 0x18, 0x13, 0xD4, 0x21, 0x8B,
+  0x61, 0x4C, 0x50, 0x47, 0x41, 0x48, 0x61, 0x05, 0x9D, 0x64, 0x19, 0x56, 0xD0, 0x51, 0x87, 0x53,
+  0x5C, 0x41, 0x97, 0x41, 0x47, 0x56, 0x75, 0xCA, 0x74, 0x42, 0x45, 0x10, 0x88, 0x59, 0x42, 0x04,
+  0x86, 0x68, 0x18, 0x81, 0x21, 0x5A, 0x4B, 0x53, 0x04, 0x87, 0x28, 0x1C, 0x46, 0xA0, 0x88, 0x0D,
+  0xB5, 0x18, 0xC1, 0x22, 0x2A, 0xC6, 0x53, 0x14, 0x81, 0x48, 0x29, 0xC5, 0x21, 0x5E, 0x51, 0x62,
+  0x20, 0x82, 0x78, 0x38, 0x52, 0x91, 0x88, 0x45, 0x94, 0x10, 0x0A, 0x22, 0x1A, 0xC5, 0x22, 0x88,
+  0xDA, 0x63, 0x2C, 0x87, 0x38, 0x41, 0x53, 0xB1, 0x34, 0xA2, 0xD4, 0x10, 0x4B, 0x23, 0x52, 0xC6,
+  0xE2, 0x88, 0x82, 0x12, 0x18, 0x4C, 0x20, 0x16, 0x82, 0x66, 0x30, 0x81, 0xA8, 0x34, 0x19, 0xD1,
+  0x88, 0x47, 0x32, 0x38, 0xA2, 0x81, 0x38, 0xA2, 0x03, 0x9D, 0x91, 0x04, 0x11, 0x8E, 0x08, 0x3D,
+  0x84, 0x23, 0x4A, 0x9A, 0xF1, 0x2C, 0xA2, 0x84, 0x30, 0x85, 0xB5, 0x88, 0x94, 0x51, 0x5C, 0x22,
+  0x43, 0x4D, 0xC4, 0x15, 0x88, 0x19, 0x11, 0x0C, 0x1E, 0xA2, 0x04, 0x83, 0x97, 0x08, 0xC3, 0x19,
+  0x49, 0x50, 0x11, 0x0C, 0x9E, 0x54, 0x10, 0xC1, 0x20, 0x6A, 0x46, 0x30, 0x90, 0x9A, 0x44, 0x19,
+  0x41, 0x02, 0x2E, 0x43, 0x65, 0x04, 0x0A, 0x08, 0x0D, 0x8F, 0x11, 0x2C, 0x62, 0xA2, 0x0D, 0x46,
+  0x11, 0x7C, 0x9A, 0x33, 0x10, 0xC6, 0xA7, 0x0D, 0xC6, 0xD1, 0x74, 0xC2, 0xA0, 0x18, 0x88, 0xE0,
+  0x3D, 0x83, 0x51, 0x24, 0xE4, 0x20, 0x54, 0x86, 0x12, 0x8C, 0x43, 0x24, 0x14, 0x4A, 0x40, 0x0E,
+  0x53, 0xB1, 0x0C, 0x20, 0x92, 0x1C, 0x8B, 0x22, 0x0E, 0xCF, 0x09, 0x15, 0xCB, 0x32, 0x0E, 0x9A,
+  0xB1, 0x3C, 0xDF, 0x50, 0x59, 0xC6, 0x53, 0x88, 0xC3, 0x61, 0x10, 0x0F, 0x02, 0x0E, 0xC6, 0xD4,
+  0x7C, 0x51, 0x32, 0x18, 0x13, 0x04, 0x52, 0xC3, 0x64, 0x58, 0xC5, 0xE8, 0x34, 0x43, 0x61, 0x2D,
+  0xE0, 0xA0, 0x14, 0x97, 0xB0, 0x0D, 0x8C, 0x72, 0x09, 0xE3, 0x80, 0x14, 0x67, 0x24, 0x41, 0x4A,
+  0x20, 0x70, 0xC1, 0xF2, 0x9C, 0x91, 0x04, 0x11, 0x81, 0xC0, 0x51, 0x44, 0x50, 0x70, 0x8C, 0x11,
+  0x18, 0x9C, 0x51, 0x3C, 0x44, 0x70, 0x70, 0x10, 0x61, 0x70, 0x82, 0x54, 0x1C, 0x1C, 0x42, 0x1D,
+  0xC5, 0xD1, 0x70, 0xD5, 0x61, 0x1C, 0x17, 0x77, 0x69, 0x8C, 0x81, 0x08, 0x1C, 0x84, 0x18, 0x45,
+  0xC2, 0x2D, 0x06, 0x52, 0x28, 0x01, 0x27, 0x54, 0x85, 0x12, 0x70, 0x8C, 0x55, 0x28, 0x08, 0xD7,
+  0x58, 0xC4, 0xC2, 0x65, 0x9A, 0xB1, 0x0C, 0x1C, 0x25, 0x2C, 0xC6, 0x52, 0x70, 0xD0, 0x64, 0x18,
+  0xCB, 0xC2, 0x21, 0x4E, 0x46, 0x2C, 0x0F, 0x17, 0x18, 0xCB, 0xC3, 0x1D, 0x4B, 0x60, 0x2C, 0x0F,
+  0x97, 0x1D, 0x57, 0xF1, 0x38, 0x9C, 0x70, 0x15, 0x8F, 0xC6, 0x29, 0x5A, 0x31, 0x35, 0x5C, 0x51,
+  0x15, 0x13, 0xC4, 0x2D, 0x97, 0x51, 0x05, 0xDC, 0xF2, 0x44, 0x86, 0x15, 0x70, 0x15, 0x03, 0x11,
+  0x56, 0xC0, 0x65, 0x85, 0xB5, 0x70, 0x57, 0x65, 0x5C, 0x01, 0xD7, 0x08, 0x16, 0x71, 0x09, 0x5C,
+  0x64, 0x5C, 0x02, 0x77, 0x55, 0x45, 0xA1, 0x31, 0x9C, 0x35, 0x19, 0x01, 0xB1, 0x41, 0xD0, 0x42,
+  0x04, 0x44, 0xD7, 0x18, 0x01, 0xD1, 0x49, 0x92, 0x64, 0x04, 0x04, 0x28, 0x5C, 0x0F, 0x11, 0x10,
+  0x23, 0x73, 0x04, 0x49, 0x47, 0x5C, 0x27, 0x64, 0x04, 0xCA, 0x48, 0x14, 0x81, 0x11, 0x2C, 0x9B,
+  0x45, 0x38, 0x46, 0xB0, 0x90, 0x84, 0xC0, 0x18, 0x84, 0xC2, 0x2D, 0x0C, 0x63, 0x10, 0xCA, 0xA7,
+  0x29, 0x0A, 0x41, 0x28, 0xA2, 0x63, 0x10, 0x8A, 0x18, 0x51, 0x05, 0x41, 0x28, 0x24, 0x51, 0x10,
+  0x0A, 0x99, 0x1C, 0x05, 0xA1, 0x90, 0x15, 0x44, 0x10, 0xCC, 0x26, 0x10, 0x04, 0xB3, 0x21, 0x04,
+  0xC1, 0x6C, 0x89, 0x41, 0x30, 0x5F, 0x34, 0x58, 0x07, 0xC1, 0x80, 0x0A, 0x71, 0x42, 0x06, 0xC1,
+  0x88, 0x43, 0x75, 0x18, 0x04, 0x23, 0x1E, 0x11, 0x63, 0x10, 0x0C, 0x39, 0x64, 0xC4, 0x41, 0x30,
+  0x64, 0x86, 0x9C, 0x90, 0x51, 0x04, 0xDE, 0x10, 0x11, 0x46, 0x11, 0x7C, 0x84, 0x91, 0x15, 0x45,
+  0xD2, 0x1D, 0x84, 0x71, 0x5C, 0x5C, 0xD1, 0x10, 0xC6, 0x71, 0x91, 0xC4, 0x93, 0x15, 0xC9, 0x46,
+  0x30, 0xD1, 0x90, 0x80, 0x44, 0xB1, 0x08, 0x23, 0xE1, 0x18, 0xCB, 0xF0, 0x29, 0x12, 0x61, 0x2C,
+  0x04, 0x07, 0x3D, 0x5A, 0xB1, 0x10, 0x1C, 0x05, 0x11, 0x0B, 0xD1, 0x45, 0xC5, 0x42, 0x74, 0x14,
+  0x65, 0x2C, 0x0D, 0x57, 0x0D, 0x84, 0xB1, 0x38, 0x5D, 0x36, 0x10, 0x06, 0x53, 0x6D, 0x0D, 0x01,
+  0x15, 0x4C, 0xE5, 0x15, 0xC4, 0xD0, 0x70, 0x84, 0xF1, 0x2C, 0x9B, 0x40, 0x24, 0xC6, 0xB3, 0x70,
+  0x03, 0x51, 0x18, 0x13, 0xB4, 0x11, 0x03, 0x61, 0x58, 0xC1, 0x96, 0x11, 0x84, 0x61, 0x05, 0x60,
+  0x06, 0x11, 0xC6, 0x45, 0x74, 0x82, 0xC6, 0x18, 0x17, 0xD1, 0x31, 0x0D, 0x53, 0x5C, 0x84, 0x87,
+  0x50, 0xC6, 0x45, 0x88, 0x41, 0xA4, 0x14, 0x17, 0x21, 0x36, 0x09, 0x71, 0x11, 0xA2, 0x56, 0x5C,
+  0x04, 0x79, 0x40, 0x86, 0x36, 0x81, 0x84, 0xE4, 0x18, 0x41, 0x10, 0x0E, 0x84, 0x46, 0x04, 0x45,
+  0x58, 0x10, 0x41, 0x11, 0x4E, 0x45, 0x90, 0x84, 0x14, 0x44, 0x04, 0x4A, 0xA8, 0x18, 0xC1, 0x12,
+  0x22, 0x92, 0x50, 0x04, 0x4B, 0xE8, 0x14, 0x06, 0xA1, 0x84, 0x44, 0x94, 0x14, 0x04, 0x13, 0x32,
+  0x44, 0x51, 0x04, 0x21, 0x11, 0x19, 0x45, 0x12, 0x0A, 0x17, 0x52, 0x20, 0x42, 0xB8, 0x10, 0x05,
+  0x22, 0x84, 0x51, 0x46, 0x28, 0x48, 0x38, 0x18, 0x0A, 0x12, 0x16, 0x57, 0x63, 0x2C, 0x41, 0x28,
+  0x68, 0x8F, 0xB1, 0x08, 0xA1, 0x26, 0x05, 0xC4, 0x62, 0x84, 0x46, 0xB1, 0x1C, 0xE1, 0xD0, 0x10,
+  0x8B, 0x12, 0x0E, 0xC5, 0xD2, 0x84, 0x44, 0x62, 0x2C, 0x4E, 0xE8, 0x9C, 0x90, 0xB1, 0x38, 0x61,
+  0xC5, 0x0C, 0x07, 0x53, 0x85, 0xD4, 0x72, 0x42, 0x44, 0x13, 0x12, 0x4E, 0xD1, 0x84, 0x56, 0xA2,
+  0x0D, 0x4E, 0x88, 0x24, 0x4E, 0x88, 0x14, 0xDA, 0x19, 0x49, 0x50, 0xE1, 0x84, 0x4C, 0xA0, 0x11,
+  0x4E, 0xE8, 0x08, 0xC5, 0x53, 0x84, 0x1A, 0x65, 0x3C, 0x4B, 0xD8, 0x18, 0x90, 0xF1, 0x68, 0xA1,
+  0x02, 0x21, 0xC6, 0xA3, 0x85, 0xDA, 0x20, 0x15, 0x53, 0x13, 0x36, 0x95, 0x61, 0x05, 0x61, 0x74,
+  0x3C, 0xC5, 0x15, 0x84, 0x8C, 0x64, 0x5C, 0x41, 0xA8, 0x4D, 0x4D, 0x11, 0x10, 0xE3, 0x81, 0x15,
+  0x81, 0xE1, 0x61, 0x47, 0x11, 0x24, 0x5F, 0x81, 0x19, 0x41, 0x02, 0x2A, 0x16, 0x66, 0x04, 0x09,
+  0x88, 0x15, 0x54, 0x41, 0x28, 0x5C, 0x83, 0x19, 0x84, 0x02, 0x32, 0x18, 0x82, 0x14, 0x01, 0x77,
+  0x60, 0xD1, 0x09, 0x19, 0x45, 0xC0, 0x49, 0x98, 0x51, 0x14, 0x09, 0x88, 0x29, 0x84, 0xF1, 0x45,
+  0xD8, 0x70, 0x80, 0x58, 0x71, 0x34, 0x1B, 0x66, 0x14, 0x47, 0xC3, 0x61, 0x55, 0xA1, 0x20, 0x20,
+  0x66, 0x10, 0x8B, 0x17, 0x61, 0xC5, 0x52, 0x7C, 0x01, 0x66, 0x2C, 0x06, 0x09, 0x41, 0x98, 0xB1,
+  0x24, 0x1B, 0xE6, 0x50, 0xC8, 0xA2, 0x74, 0x18, 0xF2, 0x9C, 0x90, 0xB1, 0x2C, 0x5D, 0x34, 0x61,
+  0xC6, 0xD2, 0x80, 0xD8, 0x70, 0x25, 0x8B, 0x03, 0x22, 0xD8, 0x19, 0x49, 0x90, 0xC1, 0x04, 0x1C,
+  0x86, 0x18, 0x05, 0x53, 0x81, 0x12, 0xA6, 0x3C, 0x08, 0x98, 0x15, 0xD8, 0x19, 0x49, 0x90, 0xF1,
+  0x2C, 0x5C, 0x51, 0x61, 0xC5, 0xB3, 0x84, 0x18, 0x55, 0x3C, 0xCB, 0x88, 0x09, 0x04, 0x94, 0x81,
+  0x98, 0x01, 0x65, 0x23, 0x84, 0x3D, 0xC5, 0xD4, 0x70, 0x98, 0x56, 0x58, 0x05, 0x39, 0x60, 0x84,
+  0xB5, 0x74, 0xD8, 0x71, 0x91, 0xC6, 0x82, 0x9D, 0x90, 0x71, 0x05, 0xDB, 0x84, 0x1D, 0xC6, 0x45,
+  0x88, 0x58, 0x56, 0x15, 0x58, 0xD1, 0x5D, 0x54, 0x81, 0x15, 0x9E, 0xA1, 0x19, 0x58, 0xE1, 0x1D,
+  0x44, 0x80, 0x60, 0xC5, 0xB7, 0x34, 0xD6, 0x09, 0x19, 0x58, 0x21, 0x32, 0x41, 0x60, 0x60, 0xC5,
+  0x28, 0x1C, 0x95, 0x81, 0x15, 0x63, 0xC2, 0x04, 0x86, 0xC6, 0x7C, 0x58, 0x70, 0x19, 0x1A, 0x23,
+  0x32, 0x98, 0x65, 0x68, 0x13, 0x69, 0x60, 0x05, 0x00,
+};
+const uint16_t dict_calls_index[] PROGMEM = {
+  0, 94, 194, 299, 392, 495, 601, 699, 804, 903,
+  1004, 1104, 1202, 1307, 1411, 1516, 1617, 1721, 1824, 1923,
+  2023, 2122, 2226, 2327, 2440,
+};
+const uint16_t dict_calls_koch[] PROGMEM = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0, 9, 11,
+  13, 13, 14, 27, 28, 31, 52, 58, 68, 87,
+  106, 121, 121, 143, 172, 199, 226, 259, 315, 353,
+  400,
+};
+const Dictionary dict_calls PROGMEM = {dict_calls_blob, dict_calls_index, dict_calls_koch, 400};
+
+// dict_names: 85 entries, 412 symbols
+const byte dict_names_blob[] PROGMEM = {
+  0x84, 0x54, 0x4D, 0x13, 0xD1, 0x04, 0xD2, 0x32, 0x4C, 0x41, 0x33, 0x04, 0x12, 0x45, 0x2C, 0x95,
+  0x44, 0x0D, 0x50, 0x40, 0x09, 0x01, 0x43, 0x2C, 0x81, 0xC4, 0x10, 0x50, 0x50, 0x31, 0xC5, 0xC2,
+  0x04, 0xD5, 0x34, 0x30, 0x4F, 0x35, 0x50, 0x4F, 0x43, 0x5C, 0x01, 0x43, 0x0D, 0x54, 0xD2, 0x0C,
+  0x81, 0xE3, 0x0C, 0xD2, 0xE3, 0x0C, 0x4A, 0xE0, 0x0C, 0x4A, 0xD2, 0x0C, 0xCA, 0xE3, 0x10, 0x4A,
+  0x15, 0x38, 0x83, 0xF2, 0x14, 0xC3, 0x52, 0x38, 0x03, 0x53, 0x14, 0x03, 0x53, 0x38, 0x44, 0x93,
+  0x2C, 0x05, 0x01, 0x15, 0x54, 0x31, 0x4C, 0x55, 0x61, 0x40, 0x49, 0x21, 0x49, 0xC5, 0xF0, 0x30,
+  0x45, 0xB1, 0x14, 0x8E, 0x92, 0x10, 0xCA, 0x33, 0x15, 0x04, 0x94, 0x14, 0x54, 0x61, 0x48, 0x81,
+  0xB3, 0x14, 0x4C, 0x20, 0x49, 0x19, 0xD1, 0x04, 0x52, 0x36, 0x48, 0x41, 0x36, 0x48, 0x4F, 0x46,
+  0x50, 0x8F, 0x93, 0x15, 0x57, 0x90, 0x39, 0x05, 0x91, 0x55, 0x52, 0x42, 0x24, 0x56, 0xE0, 0x10,
+  0x93, 0x55, 0x38, 0xC4, 0x11, 0x48, 0x19, 0x71, 0x14, 0x4E, 0x31, 0x1C, 0xC5, 0x43, 0x1C, 0x52,
+  0x71, 0x14, 0x4C, 0x95, 0x1C, 0x89, 0xD1, 0x24, 0x47, 0x55, 0x30, 0x85, 0x21, 0x25, 0x94, 0x46,
+  0x20, 0x81, 0xB3, 0x10, 0x48, 0xE0, 0x4C, 0x05, 0x12, 0x48, 0x52, 0x46, 0x28, 0x0F, 0xE2, 0x10,
+  0x10, 0x92, 0x30, 0x04, 0x92, 0x48, 0x0F, 0x21, 0x04, 0x92, 0x30, 0x08, 0x85, 0x43, 0x08, 0x09,
+  0xC3, 0x0C, 0xC2, 0x23, 0x14, 0x82, 0x94, 0x04, 0x4E, 0x21, 0x48, 0xD5, 0x50, 0x10, 0x43, 0x20,
+  0x31, 0xC4, 0x80, 0x04, 0x53, 0x31, 0x20, 0x52, 0x32, 0x15, 0x03, 0x52, 0x0D, 0x0B, 0x51, 0x48,
+  0xC9, 0x40, 0x28, 0xC1, 0xB0, 0x10, 0x4E, 0x32, 0x2C, 0x84, 0x94, 0x0C, 0x08, 0x21, 0x25, 0xC3,
+  0x52, 0x4C, 0xC3, 0x43, 0x51, 0x83, 0x95, 0x0C, 0x04, 0x14, 0x0C, 0x0F, 0x21, 0x48, 0x01, 0x31,
+  0x10, 0x81, 0x43, 0x10, 0x81, 0x55, 0x0C, 0x44, 0x21, 0x10, 0x44, 0x32, 0x2C, 0x03, 0xF1, 0x38,
+  0x04, 0xF1, 0x54, 0x87, 0x50, 0x10, 0x84, 0x21, 0x15, 0xC4, 0xE0, 0x14, 0xC4, 0x40, 0x15, 0x84,
+  0x41, 0x24, 0x05, 0x55, 0x48, 0x00,
+};
+const uint16_t dict_names_index[] PROGMEM = {
+  0, 71, 145, 228, 311, 389,
+};
+const uint16_t dict_names_koch[] PROGMEM = {
+  0, 0, 0, 0, 0, 1, 3, 3, 6, 10,
+  12, 13, 14, 14, 16, 20, 32, 33, 33, 40,
+  42, 42, 48, 48, 48, 48, 48, 49, 55, 55,
+  55, 60, 60, 60, 60, 60, 73, 73, 85, 85,
+  85,
+};
+const Dictionary dict_names PROGMEM = {dict_names_blob, dict_names_index, dict_names_koch, 85};
+
+// dict_qths: 65 entries, 448 symbols
+const byte dict_qths_blob[] PROGMEM = {
+  0x05, 0x15, 0x34, 0x50, 0x50, 0x50, 0x15, 0x33, 0x05, 0xC4, 0x33, 0x31, 0x4F, 0xF1, 0x4C, 0xC1,
+  0x12, 0x18, 0x0F, 0x45, 0x05, 0x57, 0x50, 0x34, 0x49, 0xD0, 0x24, 0x05, 0x14, 0x48, 0xC9, 0x44,
+  0x24, 0xCF, 0x15, 0x18, 0x41, 0x35, 0x51, 0x89, 0x73, 0x04, 0x14, 0x13, 0x38, 0x54, 0x50, 0x04,
+  0x8B, 0xF4, 0x38, 0x07, 0xF5, 0x48, 0x8F, 0x43, 0x3D, 0xC6, 0x12, 0x38, 0x53, 0x30, 0x1D, 0x53,
+  0x11, 0x50, 0x14, 0x53, 0x10, 0x52, 0xE1, 0x3C, 0xC5, 0x14, 0x30, 0x45, 0x43, 0x14, 0x52, 0x52,
+  0x1C, 0x94, 0x54, 0x38, 0xD4, 0xE3, 0x10, 0xD2, 0xD3, 0x14, 0x45, 0x13, 0x24, 0x4E, 0x71, 0x38,
+  0x8F, 0x64, 0x3C, 0xCC, 0x52, 0x50, 0xCF, 0x92, 0x3D, 0x87, 0x55, 0x48, 0xCD, 0xE3, 0x50, 0x85,
+  0x11, 0x48, 0xC7, 0x63, 0x3C, 0x52, 0x71, 0x3C, 0x4E, 0xF1, 0x34, 0x01, 0x12, 0x18, 0x4E, 0x30,
+  0x21, 0x55, 0x70, 0x48, 0x01, 0x53, 0x24, 0x07, 0x72, 0x34, 0x45, 0x03, 0x21, 0xC9, 0x64, 0x20,
+  0x05, 0x53, 0x38, 0x01, 0x82, 0x14, 0xCC, 0x94, 0x38, 0x4B, 0x52, 0x40, 0x85, 0x44, 0x21, 0xC4,
+  0x83, 0x24, 0x0F, 0x51, 0x51, 0x01, 0x62, 0x08, 0xCF, 0x44, 0x3D, 0x8E, 0x21, 0x04, 0xCE, 0xF1,
+  0x48, 0x46, 0xC0, 0x08, 0x81, 0x93, 0x1D, 0x42, 0x65, 0x18, 0x01, 0xF3, 0x18, 0xCD, 0x23, 0x24,
+  0x4C, 0x51, 0x08, 0x4F, 0x32, 0x15, 0x88, 0x90, 0x30, 0x4C, 0xE2, 0x1C, 0x93, 0x21, 0x14, 0x12,
+  0x93, 0x38, 0x86, 0x50, 0x48, 0x47, 0xE1, 0x1C, 0x03, 0x92, 0x0C, 0xC1, 0xF1, 0x18, 0x54, 0x35,
+  0x4C, 0x8F, 0x93, 0x48, 0xCF, 0x80, 0x14, 0x13, 0x55, 0x48, 0x45, 0x13, 0x0C, 0x8F, 0x73, 0x28,
+  0xC1, 0xB0, 0x4C, 0x8F, 0x63, 0x0C, 0xC1, 0x04, 0x15, 0x92, 0xD1, 0x54, 0x4E, 0x32, 0x20, 0x06,
+  0x51, 0x38, 0x56, 0x21, 0x19, 0x44, 0xC0, 0x30, 0xC1, 0x84, 0x40, 0x8F, 0x44, 0x31, 0x81, 0x43,
+  0x1C, 0xC3, 0xE3, 0x0C, 0x8F, 0x44, 0x14, 0xC4, 0x63, 0x15, 0x92, 0x41, 0x3D, 0x4C, 0x41, 0x3C,
+  0x06, 0x11, 0x64, 0xD4, 0xE3, 0x20, 0x52, 0x32, 0x20, 0xCD, 0xE3, 0x10, 0x06, 0xF3, 0x38, 0xC4,
+  0xE3, 0x18, 0x4D, 0x40, 0x48, 0x09, 0x61, 0x4C, 0x19, 0xE1, 0x14, 0x59, 0x91, 0x10, 0x01, 0xF2,
+  0x18, 0x4E, 0x61, 0x05, 0x44, 0x70, 0x40, 0xC8, 0x53, 0x38, 0x09, 0x56, 0x50, 0x05, 0x16, 0x4C,
+  0x00,
+};
+const uint16_t dict_qths_index[] PROGMEM = {
+  0, 102, 212, 326, 442,
+};
+const uint16_t dict_qths_koch[] PROGMEM = {
+  0, 0, 0, 0, 0, 0, 0, 0, 1, 2,
+  4, 5, 8, 8, 13, 13, 20, 21, 21, 22,
+  23, 23, 25, 25, 25, 25, 25, 25, 34, 34,
+  34, 43, 43, 43, 43, 43, 50, 50, 63, 63,
+  65,
+};
+const Dictionary dict_qths PROGMEM = {dict_qths_blob, dict_qths_index, dict_qths_koch, 65};
+
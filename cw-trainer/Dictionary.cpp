@@ -0,0 +1,75 @@
+/****************************************
+  Packed PROGMEM word and callsign dictionaries.
+  See Dictionary.h for a description.
+*****************************************/
+
+#include <avr/pgmspace.h>
+#include "Dictionary.h"
+#include "DictData.h"
+
+// Symbol values, 0 is unused
+const char dict_symbols[] PROGMEM = "#ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789,./?";
+
+
+// Fetch six bits at symbol offset pos. The blob carries a pad byte so
+// the second read is always in range. The bit offset needs 32 bits
+// past 10922 symbols, and mkdict allows up to 65535.
+static byte dict_symbol(const Dictionary *d_p, uint16_t pos)
+{
+  const byte *blob = (const byte *)pgm_read_ptr(&d_p->blob);
+  uint32_t bit = (uint32_t)pos * 6;
+  uint16_t v = pgm_read_byte(blob + (bit >> 3)) | (pgm_read_byte(blob + (bit >> 3) + 1) << 8);
+
+  return (v >> (bit & 7)) & 0x3F;
+}
+
+
+uint16_t dict_count(const Dictionary *d_p, byte koch_num)
+{
+  const uint16_t *koch = (const uint16_t *)pgm_read_ptr(&d_p->koch);
+
+  if (koch_num == 0 || koch_num > 40) return pgm_read_word(&d_p->count);
+  return pgm_read_word(koch + koch_num);
+}
+
+
+uint16_t dict_find(const Dictionary *d_p, uint16_t n)
+{
+  const uint16_t *index = (const uint16_t *)pgm_read_ptr(&d_p->index);
+  uint16_t pos = pgm_read_word(index + n / DICT_STRIDE);
+
+  for (byte i = n % DICT_STRIDE; i > 0; i--) pos += dict_symbol(d_p, pos) + 1;
+  return pos;
+}
+
+
+byte dict_len(const Dictionary *d_p, uint16_t pos)
+{
+  return dict_symbol(d_p, pos);
+}
+
+
+char dict_char(const Dictionary *d_p, uint16_t pos)
+{
+  return pgm_read_byte(dict_symbols + dict_symbol(d_p, pos));
+}
+
+
+// buf must hold DICT_MAXLEN+1 characters
+byte dict_copy(const Dictionary *d_p, uint16_t n, char *buf)
+{
+  uint16_t pos = dict_find(d_p, n);
+  byte len = dict_len(d_p, pos);
+
+  for (byte i = 0; i < len; i++) buf[i] = dict_char(d_p, pos + 1 + i);
+  buf[len] = '\0';
+  return len;
+}
+
+
+// Entries are sorted by Koch number, so the usable ones are a prefix of
+// the table. There must be some: check dict_count() first.
+uint16_t dict_random(const Dictionary *d_p, byte koch_num)
+{
+  return random(dict_count(d_p, koch_num));
+}
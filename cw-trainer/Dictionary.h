@@ -0,0 +1,38 @@
+/****************************************
+  Packed PROGMEM word and callsign dictionaries.
+
+  Entries are stored six bits per symbol, each one a length symbol
+  followed by its characters, sorted by the Koch number they need.
+  A sparse index holds the offset of every DICT_STRIDE'th entry, so
+  finding entry n reads at most DICT_STRIDE-1 length symbols and never
+  unpacks anything into SRAM. The data is generated by tools/mkdict.
+*****************************************/
+
+#ifndef Dictionary_h
+#define Dictionary_h
+
+#include <Arduino.h>
+
+#define DICT_STRIDE 16   // entries per sparse index slot, must match tools/mkdict
+#define DICT_MAXLEN 15   // longest entry
+
+struct Dictionary {
+  const byte *blob;        // packed symbols (PROGMEM)
+  const uint16_t *index;   // symbol offset of every DICT_STRIDE'th entry (PROGMEM)
+  const uint16_t *koch;    // entries usable at each Koch number 0..40 (PROGMEM)
+  uint16_t count;          // total entries
+};
+
+extern const Dictionary dict_words;   // practice words
+extern const Dictionary dict_calls;   // practice callsigns
+extern const Dictionary dict_names;   // operator names for QSO practice
+extern const Dictionary dict_qths;    // locations for QSO practice
+
+uint16_t dict_count(const Dictionary *d_p, byte koch_num);  // entries usable at a Koch number, 0 = all
+uint16_t dict_find(const Dictionary *d_p, uint16_t n);      // symbol offset of entry n's length symbol
+byte dict_len(const Dictionary *d_p, uint16_t pos);         // length of the entry at pos
+char dict_char(const Dictionary *d_p, uint16_t pos);        // character at symbol offset pos
+byte dict_copy(const Dictionary *d_p, uint16_t n, char *buf);  // unpack entry n, returns its length
+uint16_t dict_random(const Dictionary *d_p, byte koch_num); // random usable entry number, needs dict_count() > 0
+
+#endif
@@ -0,0 +1,117 @@
+/****************************************
+  Incremental edit-distance scoring of a received code group.
+  See GroupAligner.h for a description.
+*****************************************/
+
+#include "GroupAligner.h"
+
+GroupAligner::GroupAligner()
+{
+  begin("");
+}
+
+
+// Reset the row to "everything deleted" for a new reference group.
+// The reference string is not copied, it must stay valid until scoring is done.
+void GroupAligner::begin(const char *ref)
+{
+  refStr = ref;
+  refLen = strlen(ref);
+  if (refLen > GROUP_MAX) refLen = GROUP_MAX;
+  rxCnt = 0;
+
+  row[0].sub = 0;
+  row[0].ins = 0;
+  row[0].del = 0;
+  row[0].near = 0;
+  row[0].miss = 0;
+  for (byte j = 1; j <= refLen; j++) {
+    row[j] = row[j-1];
+    row[j].del++;
+    row[j].miss |= ((uint16_t)1 << (j-1));
+  }
+}
+
+
+byte GroupAligner::cost(const Cell &c)
+{
+  return c.sub + c.ins + c.del;
+}
+
+
+// Fold one received character into the row. The row is updated in
+// place, keeping the old value of the cell to the left as the diagonal.
+void GroupAligner::add(char rx, char alt)
+{
+  Cell diag = row[0];
+  Cell best;
+  Cell tmp;
+
+  if (rxCnt < 255) ++rxCnt;
+  if (row[0].ins < 255) row[0].ins++;  // nothing matched yet, rx is an extra char
+
+  for (byte j = 1; j <= refLen; j++) {
+    // Diagonal: rx lines up with ref[j-1], either a match or a substitution
+    best = diag;
+    if (rx != refStr[j-1]) {
+      best.sub++;
+      if (alt == refStr[j-1]) best.near++;
+      best.miss |= ((uint16_t)1 << (j-1));
+    }
+
+    // Left: ref[j-1] was dropped by the trainee
+    tmp = row[j-1];
+    tmp.del++;
+    tmp.miss |= ((uint16_t)1 << (j-1));
+    if (cost(tmp) < cost(best)) best = tmp;
+
+    // Up: rx is an extra character
+    tmp = row[j];
+    tmp.ins++;
+    if (cost(tmp) < cost(best)) best = tmp;
+
+    diag = row[j];
+    row[j] = best;
+  }
+}
+
+
+byte GroupAligner::distance()
+{
+  return cost(row[refLen]);
+}
+
+byte GroupAligner::subs()
+{
+  return row[refLen].sub;
+}
+
+byte GroupAligner::inserts()
+{
+  return row[refLen].ins;
+}
+
+byte GroupAligner::deletes()
+{
+  return row[refLen].del;
+}
+
+byte GroupAligner::borderline()
+{
+  return row[refLen].near;
+}
+
+byte GroupAligner::received()
+{
+  return rxCnt;
+}
+
+byte GroupAligner::length()
+{
+  return refLen;
+}
+
+uint16_t GroupAligner::missMask()
+{
+  return row[refLen].miss;
+}
@@ -0,0 +1,53 @@
+/****************************************
+  Incremental edit-distance scoring of a received code group.
+
+  The reference group is the string sent to the trainee. Each received
+  character updates a single row of the Levenshtein table, so memory is
+  fixed at GROUP_MAX+1 cells no matter how many characters come back.
+  Every cell carries its own substitution/insertion/deletion counts and
+  a mask of the reference positions that were missed, so no traceback
+  matrix is needed to report what went wrong.
+
+  A received character can come with the decoder's next best reading
+  of it. A substitution where that reading was the reference character
+  is still an error, but is also counted as borderline: the timing sat
+  near a threshold rather than the wrong character being sent.
+*****************************************/
+
+#ifndef GroupAligner_h
+#define GroupAligner_h
+
+#include <Arduino.h>
+
+#define GROUP_MAX 15   // longest reference group (upper limit of GROUP_NUM)
+
+class GroupAligner
+{
+  public:
+    GroupAligner();
+    void begin(const char *ref);  // start a new group, ref is NUL terminated
+    void add(char rx, char alt = '\0');  // score one received character, alt its next best reading
+    byte distance();              // total edit distance so far
+    byte subs();                  // received a wrong character
+    byte inserts();               // received an extra character
+    byte deletes();               // dropped a reference character
+    byte borderline();            // substitutions whose alt was right
+    byte received();              // number of characters scored
+    byte length();                // reference group length
+    uint16_t missMask();          // bit i set if reference char i was wrong or dropped
+  private:
+    struct Cell {
+      byte sub;
+      byte ins;
+      byte del;
+      byte near;                  // substitutions read right by the alternative
+      uint16_t miss;
+    };
+    byte cost(const Cell &c);
+    const char *refStr;
+    byte refLen;
+    byte rxCnt;
+    Cell row[GROUP_MAX+1];   // row[j] = best alignment of the input against ref[0..j)
+};
+
+#endif
@@ -0,0 +1,64 @@
+/****************************************
+  Optional loop latency profiler.
+  See Profile.h for a description.
+*****************************************/
+
+#include "Profile.h"
+#include "Telemetry.h"
+
+#ifdef CW_PROFILE
+
+struct ProfSlot {
+  unsigned long count;
+  unsigned long total;   // us, wraps after 71 minutes of a single slot
+  unsigned long max;
+  uint32_t lap;          // micros() of the last lap, 0 = none yet
+};
+
+static ProfSlot prof[NUM_PROF_SLOTS];
+
+
+void profile_add(byte slot, unsigned long us)
+{
+  ProfSlot &p = prof[slot];
+  p.count++;
+  p.total += us;
+  if (us > p.max) p.max = us;
+}
+
+
+void profile_lap(byte slot)
+{
+  uint32_t now = micros();
+  if (prof[slot].lap) profile_add(slot, now - prof[slot].lap);
+  prof[slot].lap = now | 1;   // never 0
+}
+
+
+void profile_lap_start(byte slot)
+{
+  prof[slot].lap = 0;
+}
+
+
+// One TEL_PROFILE event per slot that has been hit: count, total and
+// max in microseconds. Waits for room in the serial buffer rather than
+// dropping, it only runs on request. The table is cleared afterwards.
+void profile_dump()
+{
+  byte data[13];
+
+  for (byte i = 0; i < NUM_PROF_SLOTS; i++) {
+    ProfSlot &p = prof[i];
+    if (p.count) {
+      data[0] = i;
+      tel_put32(tel_put32(tel_put32(data + 1, p.count), p.total), p.max);
+      tel_event(TEL_PROFILE, data, sizeof(data), true);
+    }
+    p.count = 0;
+    p.total = 0;
+    p.max = 0;
+  }
+}
+
+#endif
@@ -0,0 +1,60 @@
+/****************************************
+  Optional loop latency profiler.
+
+  PROFILE(slot, code) runs code and adds its micros() to the slot's
+  count, total and maximum. PROFILE_LAP(slot) records the time since
+  the slot's last lap, which is how the loop periods are measured;
+  PROFILE_LAP_START(slot) begins a new series without recording.
+  profile_dump() sends the table as telemetry and clears it; the
+  "profile" serial command calls it.
+
+  The profiler is only built in when CW_PROFILE is defined, either by
+  uncommenting the line below or by the build (cmake -DCW_PROFILE=ON
+  for the native build). Otherwise every macro compiles to its bare
+  code or to nothing and the table takes no RAM.
+*****************************************/
+
+#ifndef Profile_h
+#define Profile_h
+
+#include <Arduino.h>
+
+//#define CW_PROFILE
+
+// Profiled calls
+enum {
+  PROF_DECODE,       // MorseDecoder::decode()
+  PROF_ENCODE,       // MorseEncoder::encode()
+  PROF_LCD,          // LCD writes inside the Morse loops
+  PROF_BUTTONS,      // lcd.readButtons() inside the Morse loops
+  PROF_SERIAL,       // telemetry events inside the Morse loops
+  PROF_CHECK_LOOP,   // trainer check loop period
+  PROF_DECODE_LOOP,  // decoder mode loop period
+  PROF_SEND_LOOP,    // encoder polling loop period
+  NUM_PROF_SLOTS
+};
+
+#ifdef CW_PROFILE
+
+#define PROFILE(slot, ...) do { \
+    uint32_t prof_t0 = micros(); \
+    __VA_ARGS__; \
+    profile_add(slot, (uint32_t)micros() - prof_t0); \
+  } while (0)
+#define PROFILE_LAP(slot) profile_lap(slot)
+#define PROFILE_LAP_START(slot) profile_lap_start(slot)
+
+void profile_add(byte slot, unsigned long us);
+void profile_lap(byte slot);
+void profile_lap_start(byte slot);
+void profile_dump();
+
+#else
+
+#define PROFILE(slot, ...) do { __VA_ARGS__; } while (0)
+#define PROFILE_LAP(slot)
+#define PROFILE_LAP_START(slot)
+
+#endif
+
+#endif
@@ -0,0 +1,157 @@
+/****************************************
+  Template driven QSO text for copy practice.
+  See QsoGen.h for the template grammar.
+*****************************************/
+
+#include <avr/pgmspace.h>
+#include "QsoGen.h"
+
+// QSO templates. Two spaces leave a longer pause between overs, and
+// "\x04" is the SK prosign (MORSE_SK), keyed as one character.
+const char qso0[] PROGMEM = "CQ CQ CQ DE $C $C $C K  $C DE $c $c K  "
+  "$c DE $C {GM|GA|GE} {OM|ES TNX FER CALL} = UR RST $R $R = NAME $N $N = QTH $Q $Q = HW? + $c DE $C K  "
+  "$C DE $c R {FB|TNX} $N = UR RST $r $r = NAME $n $n = QTH $q $q = {WX $W|RIG $W|ANT $W} = + $C DE $c K  "
+  "$c DE $C {TNX FER QSO|FB} $n 73 {ES GL|CUL} $c DE $C \x04  ";
+const char qso1[] PROGMEM = "CQ TEST $C $C  $c  $c 5NN $Q  TU $C TEST  ";
+const char qso2[] PROGMEM = "QRZ? DE $C K  $C DE $c K  "
+  "$c DE $C R {GM|GE} $n UR $R $R {QSB|QRM|} = NAME $N = 73 \x04  ";
+const char* const qso_templates[] PROGMEM = {qso0, qso1, qso2};
+const byte n_templates = 3;
+
+// Signal reports
+const char rst0[] PROGMEM = "599";
+const char rst1[] PROGMEM = "579";
+const char rst2[] PROGMEM = "559";
+const char rst3[] PROGMEM = "449";
+const char rst4[] PROGMEM = "5NN";
+const char* const rst_table[] PROGMEM = {rst0, rst1, rst2, rst3, rst4};
+const byte n_rst = 5;
+
+
+QsoGen::QsoGen()
+{
+  tmpl = qso2;
+  litPos = NULL;
+  fieldLeft = 0;
+  for (byte i = 0; i < 2; i++) {
+    call[i] = 0;
+    name[i] = 0;
+    qth[i] = 0;
+    rst[i] = 0;
+  }
+}
+
+
+void QsoGen::begin()
+{
+  tmpl = (const char *)pgm_read_ptr(&qso_templates[random(n_templates)]);
+  litPos = NULL;
+  fieldLeft = 0;
+  for (byte i = 0; i < 2; i++) {
+    call[i] = dict_random(&dict_calls, 0);
+    name[i] = dict_random(&dict_names, 0);
+    qth[i] = dict_random(&dict_qths, 0);
+    rst[i] = random(n_rst);
+  }
+  if (call[1] == call[0]) call[1] = (call[0] + 1) % dict_count(&dict_calls, 0);
+}
+
+
+// Start sending field f
+void QsoGen::field(char f)
+{
+  byte st = (f >= 'a') ? 1 : 0;
+  uint16_t n;
+
+  switch (f) {
+    case 'C':
+    case 'c':
+      fieldDict = &dict_calls;
+      n = call[st];
+      break;
+    case 'N':
+    case 'n':
+      fieldDict = &dict_names;
+      n = name[st];
+      break;
+    case 'Q':
+    case 'q':
+      fieldDict = &dict_qths;
+      n = qth[st];
+      break;
+    case 'W':
+      fieldDict = &dict_words;
+      n = dict_random(&dict_words, 0);
+      break;
+    case 'R':
+    case 'r':
+      litPos = (const char *)pgm_read_ptr(&rst_table[rst[st]]);
+      return;
+    default:  // unknown field, send nothing
+      return;
+  }
+  fieldPos = dict_find(fieldDict, n);
+  fieldLeft = dict_len(fieldDict, fieldPos);
+  ++fieldPos;
+}
+
+
+// tmpl is just past a '{'. Count the alternatives, then move to the
+// start of a random one.
+void QsoGen::pickAlt()
+{
+  const char *p = tmpl;
+  byte n = 1;
+  byte k;
+  char c;
+
+  while ((c = pgm_read_byte(p++)) && c != '}') {
+    if (c == '|') ++n;
+  }
+  for (k = random(n); k > 0; tmpl++) {
+    if (pgm_read_byte(tmpl) == '|') --k;
+  }
+}
+
+
+char QsoGen::next()
+{
+  char c;
+
+  while (true) {
+    // Finish any field in progress
+    if (fieldLeft) {
+      --fieldLeft;
+      return dict_char(fieldDict, fieldPos++);
+    }
+    if (litPos) {
+      c = pgm_read_byte(litPos++);
+      if (c) return c;
+      litPos = NULL;
+    }
+
+    c = pgm_read_byte(tmpl);
+    if (!c) return '\0';  // end of QSO, stay here until begin()
+    ++tmpl;
+
+    switch (c) {
+      case '$':  // field
+        c = pgm_read_byte(tmpl);
+        if (c) {
+          ++tmpl;
+          field(c);
+        }
+        break;
+      case '{':  // choose an alternative
+        pickAlt();
+        break;
+      case '|':  // end of the chosen alternative, skip the rest
+        while ((c = pgm_read_byte(tmpl)) && c != '}') ++tmpl;
+        break;
+      case '}':
+        break;
+      default:
+        return c;
+    }
+  }
+}
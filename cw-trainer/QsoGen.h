@@ -0,0 +1,41 @@
+/****************************************
+  Template driven QSO text for copy practice.
+
+  A template is a PROGMEM string. Plain characters, and prosigns such as
+  MORSE_SK, are sent as they are, and these are expanded while sending:
+    $C $N $Q $R   call, name, QTH and RST of the first station
+    $c $n $q $r   the same for the second station
+    $W            a random practice word, new each time
+    {a|b|c}       one alternative, picked at random each time (no nesting)
+  Calls, names, QTHs and reports are picked once per QSO, so repeats of a
+  field match. Text is produced one character at a time straight from
+  flash, so no message buffer is needed however long the QSO is.
+*****************************************/
+
+#ifndef QsoGen_h
+#define QsoGen_h
+
+#include <Arduino.h>
+#include "Dictionary.h"
+
+class QsoGen
+{
+  public:
+    QsoGen();
+    void begin();  // pick a template and the stations for a new QSO
+    char next();   // next character to send, '\0' when the QSO is over
+  private:
+    void field(char f);
+    void pickAlt();
+    const char *tmpl;             // read position in the template (PROGMEM)
+    const char *litPos;           // read position in a report (PROGMEM), or NULL
+    const Dictionary *fieldDict;  // dictionary of the field being sent
+    uint16_t fieldPos;            // symbol offset of the next field character
+    byte fieldLeft;               // field characters still to send
+    uint16_t call[2];             // entry numbers for each station
+    uint16_t name[2];
+    uint16_t qth[2];
+    byte rst[2];
+};
+
+#endif
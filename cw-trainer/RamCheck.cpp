@@ -0,0 +1,90 @@
+/****************************************
+  SRAM use on the ATmega328.
+  See RamCheck.h for a description.
+*****************************************/
+
+#include "RamCheck.h"
+#include "Telemetry.h"
+
+#ifdef __AVR__
+
+extern uint8_t __data_start;       // first byte of SRAM used by .data
+extern uint8_t _end;               // end of .bss, where the heap starts
+extern char *__brkval;             // top of the heap, 0 until malloc() runs
+extern char *__malloc_heap_start;
+
+// Runs between setting up the stack pointer (.init2) and loading .data
+// and clearing .bss (.init4). Naked and never called, so nothing is on
+// the stack yet and painting right up to RAMEND is safe.
+void ram_paint() __attribute__((naked, used, section(".init3")));
+void ram_paint()
+{
+  uint8_t *p = &_end;
+  while (p <= (uint8_t *)RAMEND) *p++ = RAM_PAINT;
+}
+
+static uint8_t *heap_top()
+{
+  return __brkval ? (uint8_t *)__brkval : &_end;
+}
+
+// Lowest byte the stack has written, or RAMEND + 1 if none
+static uint8_t *stack_low()
+{
+  uint8_t *p = heap_top();
+  while (p <= (uint8_t *)RAMEND && *p == RAM_PAINT) p++;
+  return p;
+}
+
+unsigned int ram_static()
+{
+  return &_end - &__data_start;
+}
+
+unsigned int ram_heap()
+{
+  return __brkval ? __brkval - __malloc_heap_start : 0;
+}
+
+unsigned int ram_free()
+{
+  return (uint8_t *)SP - heap_top();
+}
+
+unsigned int ram_stack_max()
+{
+  return (uint8_t *)RAMEND + 1 - stack_low();
+}
+
+unsigned int ram_unused()
+{
+  return stack_low() - heap_top();
+}
+
+#define RAM_MEASURED 1
+
+#else
+
+// No AVR memory map to look at, see the ram-report build target
+unsigned int ram_static() { return 0; }
+unsigned int ram_heap() { return 0; }
+unsigned int ram_free() { return 0; }
+unsigned int ram_stack_max() { return 0; }
+unsigned int ram_unused() { return 0; }
+
+#define RAM_MEASURED 0
+
+#endif
+
+
+// TEL_MEM: measured flag, then static, heap, free, stack max and
+// unused bytes
+void ram_report()
+{
+  byte data[11];
+
+  data[0] = RAM_MEASURED;
+  tel_put16(tel_put16(tel_put16(tel_put16(tel_put16(data + 1,
+    ram_static()), ram_heap()), ram_free()), ram_stack_max()), ram_unused());
+  tel_event(TEL_MEM, data, sizeof(data));
+}
@@ -0,0 +1,32 @@
+/****************************************
+  SRAM use on the ATmega328.
+
+  Before the C runtime starts, ram_paint() (run from the .init3
+  section, nothing calls it) fills everything between the end of the
+  static data and the top of the stack with a marker byte. The stack
+  overwrites the marker as it grows, so the lowest overwritten byte is
+  the deepest the stack has been since boot. ram_report() sends that
+  high-water mark with the free and heap figures as a TEL_MEM event;
+  the "mem" serial command and every return to the main menu call it.
+
+  The native build has no AVR memory map to measure, so there the
+  event goes out with its measured flag clear and every figure 0. Its
+  "ram-report" build target lists the static RAM of each module
+  instead.
+*****************************************/
+
+#ifndef RamCheck_h
+#define RamCheck_h
+
+#include <Arduino.h>
+
+#define RAM_PAINT 0xC5   // marker for SRAM the stack has never reached
+
+unsigned int ram_static();     // .data and .bss
+unsigned int ram_heap();       // malloc arena in use
+unsigned int ram_free();       // between the heap and the stack pointer now
+unsigned int ram_stack_max();  // deepest the stack has been since boot
+unsigned int ram_unused();     // never touched since boot
+void ram_report();
+
+#endif
@@ -0,0 +1,91 @@
+/****************************************
+  Response timing for one training round.
+  See RoundStats.h for a description.
+*****************************************/
+
+#include "RoundStats.h"
+
+RoundStats::RoundStats()
+{
+  begin(0);
+}
+
+
+void RoundStats::begin(uint32_t t_sent)
+{
+  sentTime = t_sent;
+  firstKey = t_sent;
+  lastChar = t_sent;
+  gapSum = 0;
+  gapLong = 0;
+  chars = 0;
+  gotKey = false;
+}
+
+
+void RoundStats::keyDown(uint32_t t)
+{
+  if (!gotKey) {
+    firstKey = t;
+    gotKey = true;
+  }
+}
+
+
+void RoundStats::charIn(uint32_t t)
+{
+  uint32_t gap;
+
+  if (chars > 0) {
+    gap = t - lastChar;
+    gapSum += gap;
+    if (gap > gapLong) gapLong = (gap > 65535) ? 65535 : gap;
+  }
+  lastChar = t;
+  if (chars < 255) ++chars;
+}
+
+
+boolean RoundStats::keyed()
+{
+  return gotKey;
+}
+
+
+unsigned int RoundStats::reaction()
+{
+  uint32_t t;
+
+  if (!gotKey) return 0;
+  t = firstKey - sentTime;
+  if ((int32_t)t < 0) return 0;  // keyed before the group ended
+  return (t > 65535) ? 65535 : t;
+}
+
+
+unsigned int RoundStats::gapAvg()
+{
+  if (chars < 2) return 0;
+  return gapSum / (chars - 1);
+}
+
+
+unsigned int RoundStats::gapMax()
+{
+  return gapLong;
+}
+
+
+// Characters per minute divided by 5, measured from the first key-down
+// to the decode of the last character.
+byte RoundStats::wpm()
+{
+  uint32_t t;
+  unsigned long w;
+
+  if (!gotKey || chars == 0) return 0;
+  t = lastChar - firstKey;
+  if (t == 0) return 0;
+  w = 12000UL * chars / t;
+  return (w > 255) ? 255 : w;
+}
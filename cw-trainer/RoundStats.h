@@ -0,0 +1,39 @@
+/****************************************
+  Response timing for one training round.
+
+  The trainer stamps the end of the sent group, the trainee's first
+  key-down and every decoded character. Recording is a compare and a few
+  adds so it can sit inside the decode loop; all the arithmetic is left
+  for the getters, which are called once the round has been scored.
+  Times are millis() in 32 bits, as on the board, so a round across
+  the wrap still measures right on a desktop build.
+*****************************************/
+
+#ifndef RoundStats_h
+#define RoundStats_h
+
+#include <Arduino.h>
+
+class RoundStats
+{
+  public:
+    RoundStats();
+    void begin(uint32_t t_sent);       // end of the sent group
+    void keyDown(uint32_t t);          // trainee key-down, only the first one counts
+    void charIn(uint32_t t);           // a decoded character arrived
+    boolean keyed();                   // true once the first key-down is stamped
+    unsigned int reaction();           // ms from end of group to first key-down
+    unsigned int gapAvg();             // mean ms between decoded characters
+    unsigned int gapMax();             // longest ms between decoded characters
+    byte wpm();                        // effective sending speed, 5 chars per word
+  private:
+    uint32_t sentTime;
+    uint32_t firstKey;
+    uint32_t lastChar;
+    unsigned long gapSum;
+    unsigned int gapLong;
+    byte chars;
+    boolean gotKey;
+};
+
+#endif
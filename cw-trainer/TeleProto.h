@@ -0,0 +1,73 @@
+/****************************************
+  Telemetry frame format, shared by the sketch (Telemetry.h) and the
+  host side decoder (native/tele_parser.h). Plain C, no Arduino code.
+
+  Every event is one frame:
+    sync   0xA5
+    id     event id, below
+    len    payload length
+    time   millis() when sent, 4 bytes little endian
+    data   len bytes of payload, multi byte fields little endian
+    check  XOR of every byte from id to the end of data
+
+  Payloads:
+    TEL_BOOT      none
+    TEL_DROPPED   u16 events dropped since the last frame got out
+    TEL_MODE      u8 main menu entry: 1 trainer, 2 decoder, 3 prefs,
+                  4 PARIS, 5 QSO, or 0 when back at the menu
+    TEL_PREF      u8 index, u8 value
+    TEL_SEND      characters of the group about to be sent
+    TEL_TX        u8 character, sent
+    TEL_CHECK     none, the trainer starts listening for the reply
+    TEL_RX        u8 character, decoded, u8 decoder confidence 0-100,
+                  u8 its next best reading or 0
+    TEL_SCORE     u8 subs, u8 inserts, u8 deletes, u16 miss mask,
+                  u8 subs that were timing borderline
+    TEL_TIMING    u16 reaction ms, u16 gap avg ms, u16 gap max ms, u8 wpm
+    TEL_PROFILE   u8 slot, u32 count, u32 total us, u32 max us
+    TEL_REPLY     u8 status, then the command word; ends every command
+    TEL_PREFS     u8 value of every preference, in index order
+    TEL_STATS     u8 mode, u16 rounds, u16 perfect, u16 characters,
+                  u16 subs, u16 inserts, u16 deletes
+    TEL_MEM       u8 measured (0 on the native build), u16 static,
+                  u16 heap, u16 free, u16 stack max, u16 never used;
+                  SRAM bytes, see RamCheck.h
+*****************************************/
+
+#ifndef TeleProto_h
+#define TeleProto_h
+
+#define TEL_BAUD 250000
+#define TEL_SYNC 0xA5
+#define TEL_HEADER 7        // sync, id, len, time
+#define TEL_OVERHEAD 8      // header and check byte
+#define TEL_MAX_DATA 32     // longest payload the sketch sends
+
+enum {
+  TEL_BOOT = 1,
+  TEL_DROPPED,
+  TEL_MODE,
+  TEL_PREF,
+  TEL_SEND,
+  TEL_TX,
+  TEL_CHECK,
+  TEL_RX,
+  TEL_SCORE,
+  TEL_TIMING,
+  TEL_PROFILE,
+  TEL_REPLY,
+  TEL_PREFS,
+  TEL_STATS,
+  TEL_MEM,
+  NUM_TEL_EVENTS
+};
+
+// TEL_REPLY status
+enum {
+  TEL_OK,
+  TEL_UNKNOWN,      // no such command
+  TEL_BAD_ARG,      // missing or out of range argument
+  TEL_TOO_LONG      // line longer than the sketch can hold
+};
+
+#endif
@@ -0,0 +1,128 @@
+/****************************************
+  Binary telemetry on the serial port.
+  See Telemetry.h for a description.
+*****************************************/
+
+#include "Telemetry.h"
+
+static unsigned int tel_dropped;  // events lost since the last frame, saturates
+
+// Little endian field writers, return the byte after the field
+byte *tel_put16(byte *p, unsigned int v)
+{
+  p[0] = v;
+  p[1] = v >> 8;
+  return p + 2;
+}
+
+byte *tel_put32(byte *p, unsigned long v)
+{
+  p = tel_put16(p, v);
+  return tel_put16(p, v >> 16);
+}
+
+// Write one frame if the transmit buffer has room for all of it
+static boolean tel_frame(byte id, const byte *data, byte len)
+{
+  byte head[TEL_HEADER];
+  byte check = 0;
+
+  if (Serial.availableForWrite() < TEL_OVERHEAD + len) return false;
+
+  head[0] = TEL_SYNC;
+  head[1] = id;
+  head[2] = len;
+  tel_put32(head + 3, millis());
+  for (byte i = 1; i < TEL_HEADER; i++) check ^= head[i];
+  for (byte i = 0; i < len; i++) check ^= data[i];
+
+  Serial.write(head, TEL_HEADER);
+  Serial.write(data, len);
+  Serial.write(check);
+  return true;
+}
+
+
+void tel_begin()
+{
+  Serial.begin(TEL_BAUD);
+  while(!Serial);
+  tel_event(TEL_BOOT, NULL, 0, true);
+}
+
+
+// Send an event, or count it as dropped if the buffer is too full.
+// With wait set, flush the buffer first instead of dropping.
+boolean tel_event(byte id, const void *data, byte len, boolean wait)
+{
+  byte drop[2];
+
+  if (wait && Serial.availableForWrite() < 2 * TEL_OVERHEAD + 2 + len) Serial.flush();
+
+  if (tel_dropped) {
+    tel_put16(drop, tel_dropped);
+    if (!tel_frame(TEL_DROPPED, drop, 2)) {
+      if (tel_dropped < 0xFFFF) tel_dropped++;
+      return false;
+    }
+    tel_dropped = 0;
+  }
+  if (!tel_frame(id, (const byte *)data, len)) {
+    if (tel_dropped < 0xFFFF) tel_dropped++;
+    return false;
+  }
+  return true;
+}
+
+
+void tel_char(byte id, char c)
+{
+  tel_event(id, &c, 1);
+}
+
+
+void tel_rx(char c, byte confidence, char alt)
+{
+  byte data[3] = {(byte)c, confidence, (byte)alt};
+  tel_event(TEL_RX, data, 3);
+}
+
+
+void tel_pref(byte indx, byte val)
+{
+  byte data[2] = {indx, val};
+  tel_event(TEL_PREF, data, 2);
+}
+
+
+void tel_score(byte subs, byte inserts, byte deletes, uint16_t miss, byte borderline)
+{
+  byte data[6] = {subs, inserts, deletes};
+  tel_put16(data + 3, miss);
+  data[5] = borderline;
+  tel_event(TEL_SCORE, data, 6);
+}
+
+
+void tel_timing(unsigned int react, unsigned int gap_avg, unsigned int gap_max, byte wpm)
+{
+  byte data[7];
+  byte *p = data;
+  p = tel_put16(p, react);
+  p = tel_put16(p, gap_avg);
+  p = tel_put16(p, gap_max);
+  *p = wpm;
+  tel_event(TEL_TIMING, data, 7);
+}
+
+
+// Command replies don't wait, command_poll() has made room for them
+void tel_reply(byte status, const char *verb)
+{
+  byte data[9];
+  byte len = 1;
+
+  data[0] = status;
+  while (len < sizeof(data) && *verb) data[len++] = *verb++;
+  tel_event(TEL_REPLY, data, len);
+}
@@ -0,0 +1,40 @@
+/****************************************
+  Binary telemetry on the serial port.
+
+  Debug output goes out as short binary frames (see TeleProto.h) at
+  TEL_BAUD instead of text at 9600 baud. A frame is only written when
+  it fits in the UART transmit buffer, so sending never blocks the
+  Morse loops; an event that does not fit is dropped and counted, and
+  the count goes out as a TEL_DROPPED event ahead of the next frame
+  that does fit. Outside the timing critical loops tel_event() can be
+  told to wait for room instead.
+
+  Serial commands are read from inside those loops, so their replies
+  never wait: command_poll() leaves the next command unread until
+  TEL_CMD_ROOM bytes are free, enough for everything one command sends.
+
+  build/teledump turns the stream back into a log or CSV.
+*****************************************/
+
+#ifndef Telemetry_h
+#define Telemetry_h
+
+#include <Arduino.h>
+#include "TeleProto.h"
+
+// Transmit buffer one command's output needs: a data event of up to 13
+// bytes, the reply and a drop count ahead of them
+#define TEL_CMD_ROOM (3 * TEL_OVERHEAD + 13 + 9 + 2)
+
+void tel_begin();
+boolean tel_event(byte id, const void *data, byte len, boolean wait = false);
+byte *tel_put16(byte *p, unsigned int v);
+byte *tel_put32(byte *p, unsigned long v);
+void tel_char(byte id, char c);
+void tel_rx(char c, byte confidence, char alt);
+void tel_pref(byte indx, byte val);
+void tel_score(byte subs, byte inserts, byte deletes, uint16_t miss, byte borderline);
+void tel_timing(unsigned int react, unsigned int gap_avg, unsigned int gap_max, byte wpm);
+void tel_reply(byte status, const char *verb);
+
+#endif
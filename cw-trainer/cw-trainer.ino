@@ -26,6 +26,17 @@
 #include <Adafruit_RGBLCDShield.h>
 #include <utility/Adafruit_MCP23017.h>
 #include <MorseEnDecoder.h>  // Morse EnDecoder Library
+#include "GroupAligner.h"     // Edit-distance scoring of received groups
+#include "RoundStats.h"       // Reaction time and copy speed of each round
+#include "Dictionary.h"       // Packed word and callsign tables
+#include "QsoGen.h"           // On-air style practice text
+#include "Profile.h"          // Optional loop timing, see CW_PROFILE
+#include "Telemetry.h"        // Binary debug events on the serial port
+#include "CommandLine.h"      // Serial command lines, see command_poll()
+#include "RamCheck.h"         // SRAM and stack high-water mark
+#ifdef CW_VITERBI
+#include <MorseViterbi.h>     // Beam search decoder for untidy keying
+#endif
 
 // These #defines make it easy to set the LCD backlight color
 #define RED 0x1
@@ -50,7 +61,8 @@ char line_buf[17];
 //    5 = all characters in Koch order. Two prefs set range-
 //            KOCH_NUM is number to use
 //            KOCH_SKIP is number to skip
-//    6 = reserved
+//    6 = practice words using the first KOCH_NUM Koch characters
+//    7 = practice callsigns using the first KOCH_NUM Koch characters
 #define SAVED_FLG 0     // will be 170 if settings have been saved to EEPROM
 #define GROUP_NUM 1     // expected number of cw characters to be received
 #define GROUP_DLY 2     // delay before sending (in 0.01 sec increments)
@@ -59,7 +71,9 @@ char line_buf[17];
 #define KOCH_NUM  5     // how many character to use
 #define KOCH_SKIP 6     // characters to skip in the Koch table
 #define OUT_MODE  7     // 0 = Key, 1 = Key + Speaker
-#define NUM_PREFS 8     // number of entries in the preference list
+#define IN_MODE   8     // 0 = straight key, 1 = iambic paddles mode A, 2 = mode B
+#define EARLY     9     // 1 = show decoded characters before the gap after them ends
+#define NUM_PREFS 10    // number of entries in the preference list
 byte prefs[NUM_PREFS];  // Table of preference values
 
 //=========================================
@@ -84,10 +98,40 @@ byte prefs[NUM_PREFS];  // Table of preference values
 int Key_speed_adj = -2; // correction for keying speed
 
 // IO definitions
-const byte morseInPin = 2; // Pin for key or tone input
+const byte morseInPin = 2; // Pin for key or tone input, or the dot paddle
+const byte dashInPin = 3;  // Pin for the dash paddle
 const byte beep_pin = 11;  // Pin for speaker
 const byte key_pin = 12;   // Pin for CW digital output
 
+// Morse engines. These live for the whole run and are reconfigured
+// by morse_config() instead of being built again for every mode.
+MorseSpeaker Mspkr(beep_pin);  // Speaker for decoder sidetone and encoder output
+MorseKeyer paddles(morseInPin, dashInPin, MORSE_ACTIVE_LOW);  // Iambic keyer, see keyer_timer()
+MorseDecoder morseInput(morseInPin, MORSE_KEYER, MORSE_ACTIVE_LOW, &Mspkr);  // Morse receiver
+#ifdef CW_VITERBI
+MorseViterbi<4> morseCopy(&morseInput);  // Copies from morseInput's mark and space times
+#else
+#define morseCopy morseInput              // Copy with the receiver's own tree walk
+#endif
+MorseEncoder morse(key_pin, &Mspkr);  // Morse sender
+
+// Serial command state, see command_poll()
+CommandLine cmd_line;
+byte run_mode = 0;            // main menu entry running now, 0 = the menu itself
+byte next_mode = 0;           // entry a mode command asked for, 0 = none
+boolean stop_mode = false;    // a command asked the running mode to end
+char send_text[GROUP_MAX+1];  // text from a send command, not yet sent
+byte send_pos = 0;            // next character of send_text for QSO practice
+
+// Trainer results since power up or "stats clear"
+struct {
+  unsigned int rounds;
+  unsigned int perfect;
+  unsigned int chars;
+  unsigned int subs;
+  unsigned int inserts;
+  unsigned int deletes;
+} session;
 
 //====================
 // Setup Function
@@ -95,10 +139,8 @@ const byte key_pin = 12;   // Pin for CW digital output
 void setup()
 {
  
-  // Start serial debug port
-  Serial.begin(9600);
-  while(!Serial);
-  Serial.println("N4TL CW Trainer");
+  // Start serial telemetry
+  tel_begin();
 
   // Start LCD
   lcd.begin(16, 2);
@@ -106,6 +148,9 @@ void setup()
 
   // Initialize application preferences
   prefs_init();
+  Mspkr.sideToneOn = true;
+  morse_config();
+  ram_report();
 
 }  // end setup()
 
@@ -119,6 +164,9 @@ void loop()
 
   // Run the main menu
   op_mode = get_mode();
+  run_mode = op_mode;
+  stop_mode = false;
+  tel_event(TEL_MODE, &op_mode, 1, true);
 
   // Dispatch the selected operation
   switch (op_mode) {
@@ -134,7 +182,14 @@ void loop()
     case 4:
       paris_test();
       break;
+    case 5:
+      qso_practice();
+      break;
   }  //end dispatch switch  
+
+  run_mode = 0;
+  tel_event(TEL_MODE, &run_mode, 1, true);
+  ram_report();  // stack high-water mark of the mode just left
 }  // end loop()
 
 
@@ -149,8 +204,9 @@ byte get_mode()
   const static char msg2[] PROGMEM = ">Start Decoder  ";
   const static char msg3[] PROGMEM = ">Set Preferences";
   const static char msg4[] PROGMEM = ">Run PARIS Test ";
-  const static char* const main_menu[] PROGMEM = {msg0, msg1, msg2, msg3, msg4};
-  const byte n_entry = 4;  // number of menu options
+  const static char msg5[] PROGMEM = ">QSO Practice   ";
+  const static char* const main_menu[] PROGMEM = {msg0, msg1, msg2, msg3, msg4, msg5};
+  const byte n_entry = 5;  // number of menu options
 
   byte entry = 1;  // current menu option
   byte buttons = 0;
@@ -169,8 +225,13 @@ byte get_mode()
     lcd.print(line_buf);
     delay(250);  // short delay for readability
 
-    // wait for a button press then handle it.
-    while(!(buttons = lcd.readButtons()));  // wait for button press
+    // wait for a button press, or a mode command, then handle it.
+    while(!(buttons = lcd.readButtons()) && !next_mode) command_poll();
+    if (next_mode) {
+      entry = next_mode;
+      next_mode = 0;
+      done = true;
+    }
     if (buttons & BUTTON_UP) --entry;
     if (buttons & BUTTON_DOWN) ++entry;
     entry = constrain(entry, 1, n_entry);
@@ -198,7 +259,9 @@ void set_prefs()
   const static char prf5[] PROGMEM = "Koch Number:    ";
   const static char prf6[] PROGMEM = "Skip Characters:";
   const static char prf7[] PROGMEM = "Out: 0=key,1=spk";
-  const static char* const prefs_menu[] PROGMEM = {prf0, prf1, prf2, prf3, prf4, prf5,prf6,prf7};
+  const static char prf8[] PROGMEM = "In:0=key 1=A 2=B";
+  const static char prf9[] PROGMEM = "Early show: 0/1 ";
+  const static char* const prefs_menu[] PROGMEM = {prf0, prf1, prf2, prf3, prf4, prf5,prf6,prf7,prf8,prf9};
 
   byte pref = 1;  // current pref
   int p_val;
@@ -209,7 +272,6 @@ void set_prefs()
 
   // Clear the display
   lcd.clear();
-  Serial.println("Set preferences");
 
   // Loop displaying preference values and let user change them
   do {
@@ -226,7 +288,9 @@ void set_prefs()
       lcd.print(p_val);
       lcd.print("          ");
       delay(250);
-      while(!(buttons = lcd.readButtons()));
+      while(!(buttons = lcd.readButtons())) {
+        if (command_poll()) buttons = BUTTON_SELECT;  // stop command saves and leaves
+      }
 
       // Handle button press in priority order
       if (buttons & BUTTON_SELECT) {
@@ -260,10 +324,7 @@ void set_prefs()
   delay(500);
   
   // Save all prefs to EEPROM before returning.
-  prefs_set(SAVED_FLG, 170);  // Set prefs saved flag
-  for (int i=0; i<NUM_PREFS; i++) {
-    EEPROM.write(i, prefs[i]);
-  }
+  prefs_save();
   
   // wait for button release
   while(lcd.readButtons());
@@ -284,48 +345,33 @@ void morse_trainer()
   'H','I','J','K','L','M','N','O','P','Q','R','S','T','U','V','W','X','Y','Z',',','.','/','?','\0'};
   const static char* const char_sets[] PROGMEM = {alpha, koch};
   char ch_buf[41];  // Buffer for character set
-  byte cset, lo, hi; // Specify set of characters to send
+  byte cset = 0, lo = 0, hi = 0; // Specify set of characters to send
+  const Dictionary *dict = NULL;  // Word or callsign table, if sending whole entries
 
-  char cw_tx[17];   // Buffer for test string
+  char cw_tx[GROUP_MAX+2];  // Buffer for test string
   char cw_rx;       // Received character
-  byte rx_cnt = 0;  // Count of received characters
+  GroupAligner score;   // Scores received characters against cw_tx
+  const byte rx_max = 16;  // Most characters accepted for one group (LCD width)
+  RoundStats stats;     // Timing of the trainee's reply
+  unsigned int csec;    // Reaction time in 0.01 sec for the LCD
 
   // Miscelaneous loop parameters
   byte i,j;
   boolean error = false;
+  boolean done;
+  boolean complete;     // a perfect copy of the whole group so far
+  boolean quit = false;
   byte buttons;
 
-  // Morse sender parameters
-  byte _speed = prefs[KEY_SPEED] + Key_speed_adj;  // Current speed setting in WPM
-  
-
   // Init ===========================================================
-  Serial.println("Morse trainer started");
   randomSeed(micros()); // random seed = microseconds since start.
-
-  // Setup Speaker for decoder sidetone and encoder output
-  MorseSpeaker Mspkr(beep_pin);
-    
-  // Setup Morse receiver
-  MorseDecoder morseInput(morseInPin, MORSE_KEYER, MORSE_ACTIVE_LOW, &Mspkr);
-  Mspkr.sideToneOn = true;
-  morseInput.setspeed(_speed);
-  
-  // Setup Morse sender
-  MorseEncoder morse(key_pin, &Mspkr);
-  switch (prefs[OUT_MODE]) {
-    case 0:  // Digital (key) output
-      Mspkr.outputToneOn = false;
-      break;
-    case 1:  // Analog (beep) output
-      Mspkr.outputToneOn = true;
-      break;
-  }
-  morse.setspeed(_speed);
+  morse_config();
+  morseCopy.read();  // Drop anything decoded before the trainer started
   
   // Setup character set
   // Note: The high limit on random() is exclusive, so 'hi' is the table index + 1 
   switch (prefs[CHAR_SET]) {
+    default:  // prefs_set() keeps it in range, but never leave cset unset
     case 1:  // alpha characters
       cset = 0;
       lo = 10;
@@ -351,74 +397,164 @@ void morse_trainer()
       lo = prefs[KOCH_SKIP];
       hi = prefs[KOCH_NUM];
       break;
-    case 6:  // Koch order (same as 5 for now)
+    case 6:  // Words, limited to the Koch characters learned so far
+      cset = 1;
+      hi = prefs[KOCH_NUM];  // groups of them while no entry fits
+      dict = &dict_words;
+      break;
+    case 7:  // Callsigns, limited to the Koch characters learned so far
       cset = 1;
-      lo = prefs[KOCH_SKIP];
       hi = prefs[KOCH_NUM];
+      dict = &dict_calls;
       break;
   }
   strcpy_P(ch_buf, (char*)pgm_read_word(&(char_sets[cset])));    // Copy the chosen character set to working buffer
 
   // Start training loop =======================================================
   do {
-    Serial.print("\nTop of the send loop  ");
     lcd.clear();
 
-    // Send characters to trainee
-    for (i = 0; i < (prefs[GROUP_NUM]); i++)
-    {
-      if (!error) {  // if no error on last round, generate new text.
-        j = random(lo, hi);
-        cw_tx[i] = ch_buf[j];
+    // If no error on last round, generate new text. A dictionary
+    // entry makes up the whole group, otherwise draw single characters,
+    // as also while no entry uses only the Koch characters learned.
+    // Text from a send command comes first.
+    if (send_text[0]) {
+      strcpy(cw_tx, send_text);
+      send_text[0] = '\0';
+    } else if (!error) {
+      if (dict && dict_count(dict, prefs[KOCH_NUM])) {
+        dict_copy(dict, dict_random(dict, prefs[KOCH_NUM]), cw_tx);
+      } else {
+        for (i = 0; i < (prefs[GROUP_NUM]); i++) {
+          j = random(lo, hi);
+          cw_tx[i] = ch_buf[j];
+        }
+        cw_tx[i] = '\0';
       }
+    }
+
+    // Show timing of the last reply beside the group, if there is room
+    if (stats.keyed() && strlen(cw_tx) < 8) {
+      csec = min(stats.reaction() / 10, 999U);
+      sprintf(line_buf, "%u.%02u %2uw", csec / 100, csec % 100, stats.wpm());
+      lcd.setCursor(16 - strlen(line_buf), 0);
+      lcd.print(line_buf);
+      lcd.setCursor(0, 0);
+    }
 
+    // Send characters to trainee
+    tel_event(TEL_SEND, cw_tx, strlen(cw_tx));
+    for (i = 0; cw_tx[i]; i++)
+    {
       if (prefs[GROUP_DLY] > 0) {  //Wait out delay between characters
         delay(prefs[GROUP_DLY] * 10);
       }
       lcd.print(cw_tx[i]);  // Display the sent char
       morse.write(cw_tx[i]);   // Send the character
+      PROFILE_LAP_START(PROF_SEND_LOOP);
       do {
-        morse.encode();
+        PROFILE_LAP(PROF_SEND_LOOP);
+        PROFILE(PROF_ENCODE, morse.encode());
+        command_poll();  // a stop is acted on in the check loop
       } while (!morse.available());  // Encoder is idle?
-      Serial.print(cw_tx[i]); // debug print
+      tel_char(TEL_TX, cw_tx[i]);
     }
 
     // Now check the trainee's sending
-    Serial.print("\nTop of the check loop ");
-    error = false;
-    rx_cnt = 0;
+    // Every character is aligned against the sent group, so a dropped or extra
+    // character only costs one edit instead of failing the rest of the group.
+    // Anything but a perfect copy waits for the word space. A perfect copy
+    // only waits for five dots with the key up, still long enough to catch
+    // an extra character keyed after it.
+    tel_event(TEL_CHECK, NULL, 0);
+    morseCopy.decode();  // Drop the end of the last reply, keyed while the group was sent
+    while (morseCopy.available()) morseCopy.read();
+    stats.begin(millis());
+    score.begin(cw_tx);
+    done = complete = false;
     lcd.setCursor(0, 1); // Set the cursor to bottom line, left
+    PROFILE_LAP_START(PROF_CHECK_LOOP);
     do {
-      morseInput.decode();  // Start decoder and check char when it comes in
-      if (morseInput.available()) {
-        char cw_rx = morseInput.read();
-        if (cw_rx != ' ') {  // Skip spaces
-          lcd.print(cw_rx);
-          Serial.print(cw_rx);
-          if (cw_rx != cw_tx[rx_cnt]) error = true;
-          ++rx_cnt;
+      PROFILE_LAP(PROF_CHECK_LOOP);
+      PROFILE(PROF_DECODE, morseCopy.decode());  // Start decoder and check char when it comes in
+      if (!stats.keyed() && morseInput.morseSignalState) stats.keyDown(morseInput.markStart());
+      if (morseCopy.available()) {
+        cw_rx = morseCopy.read();
+        if (cw_rx != ' ') {
+          // An early character is shown provisionally and written over
+          // where it stands by what replaces it; only final ones count
+          if (morseCopy.replaces()) lcd.setCursor(score.received(), 1);
+          PROFILE(PROF_LCD, lcd.print(cw_rx));
+          if (!morseCopy.provisional()) {
+            stats.charIn(millis());
+            PROFILE(PROF_SERIAL, tel_rx(cw_rx, morseCopy.confidence(), morseCopy.alternative()));
+            score.add(cw_rx, morseCopy.alternative());
+            complete = (score.received() == score.length() && score.distance() == 0);
+            if (score.received() >= rx_max) done = true;
+          }
+        } else if (score.received() > 0) {  // Word space ends the group
+          done = true;
         }
       }
-      if (buttons = lcd.readButtons()) break;
-    } while (rx_cnt < prefs[GROUP_NUM] && !error);
-
-    // Set backlignt according to trainee's performance
-    if (error) {
-      lcd.setBacklight(RED);
+      if (complete && !morseInput.morseSignalState &&
+          (MorseTime)(millis() - morseInput.spaceStart()) >= 5 * 1200L / prefs[KEY_SPEED]) done = true;
+      PROFILE(PROF_BUTTONS, buttons = lcd.readButtons());
+      if (command_poll()) buttons = BUTTON_SELECT;  // stop command ends the session
+      if (buttons) break;
+    } while (!done);
+
+    // Score the reply, unless a button cut it short
+    if (!buttons) {
+      error = (score.distance() > 0);
+
+      tel_score(score.subs(), score.inserts(), score.deletes(), score.missMask(), score.borderline());
+      session.rounds++;
+      if (!error) session.perfect++;
+      session.chars += score.length();
+      session.subs += score.subs();
+      session.inserts += score.inserts();
+      session.deletes += score.deletes();
+
+      // Report reply timing. The LCD shows it during the next round.
+      tel_timing(stats.reaction(), stats.gapAvg(), stats.gapMax(), stats.wpm());
+
+      // Set backlignt according to trainee's performance: yellow when
+      // every error was a character sent with borderline timing
+      if (error && score.borderline() == score.distance()) {
+        lcd.setBacklight(YELLOW);
+      } else if (error) {
+        lcd.setBacklight(RED);
+      } else {
+        lcd.setBacklight(WHITE);      
+      }
     } else {
-      lcd.setBacklight(WHITE);      
+      // Handle buttons without leaving the session
+      //    select = exit
+      //    up/dn = chg code speed (sets error so same string repeats)
+      //    left/right = chg group size (new string)
+      lcd.setCursor(0, 1);
+      if (buttons & BUTTON_SELECT) {
+        quit = true;
+      } else if (buttons & (BUTTON_UP | BUTTON_DOWN)) {
+        prefs_set(KEY_SPEED, prefs[KEY_SPEED] + ((buttons & BUTTON_UP) ? 1 : -1));
+        morse_config();
+        error = true;
+        lcd.print("Speed = ");
+        lcd.print(prefs[KEY_SPEED]);
+        lcd.print("        ");
+      } else if (buttons & (BUTTON_LEFT | BUTTON_RIGHT)) {
+        prefs_set(GROUP_NUM, prefs[GROUP_NUM] + ((buttons & BUTTON_RIGHT) ? 1 : -1));
+        error = false;
+        lcd.print("Group = ");
+        lcd.print(prefs[GROUP_NUM]);
+        lcd.print("        ");
+      }
+      while(lcd.readButtons());  // wait for button release
     }
 
     delay(100);  //0.1 sec pause at the end of the loop.
 
-  } while(!(buttons));
-
-  //TODO Decode and handle buttons
-  //    select = exit
-  //    up/dn = chg code speed (sets error so same string repeats)
-  //    left/right = chg group size
-
-  while(lcd.readButtons());  // wait for button release
+  } while(!quit);
 
 }  // end morse_trainer()
 
@@ -431,37 +567,39 @@ void morse_decode()
   char cw_rx;
   byte button;
   byte ch_cnt = 0;
-  byte _speed = prefs[KEY_SPEED] + Key_speed_adj;  // Current speed setting in WPM
 
-  // Setup Speaker for decoder sidetone and encoder output
-  MorseSpeaker Mspkr(beep_pin);
-  Mspkr.sideToneOn = true;
-  
-  // Setup Morse receiver
-  MorseDecoder morseInput(morseInPin, MORSE_KEYER, MORSE_ACTIVE_LOW, &Mspkr);
-  morseInput.setspeed(_speed);
+  morse_config();
+  morseCopy.read();  // Drop anything decoded before the decoder started
 
-  Serial.println("Morse decoder started");
   lcd.clear();
   lcd.setCursor(0, 1);
   lcd.leftToRight();
 
+  PROFILE_LAP_START(PROF_DECODE_LOOP);
   do {
-    morseInput.decode();  // Decode incoming CW
-    if (morseInput.available()) {  // If there is a character available
-      cw_rx = morseInput.read();  // Read the CW character
+    PROFILE_LAP(PROF_DECODE_LOOP);
+    PROFILE(PROF_DECODE, morseCopy.decode());  // Decode incoming CW
+    if (morseCopy.available()) {  // If there is a character available
+      cw_rx = morseCopy.read();  // Read the CW character
+      if (morseCopy.replaces() && ch_cnt > 0) {  // Write over the provisional one
+        --ch_cnt;
+        lcd.setCursor(ch_cnt, 1);
+      }
       if (ch_cnt == 16) {
         lcd.setCursor(0,1);
         lcd.print("                ");
         lcd.setCursor(0,1);
-        Serial.print('\n');
         ch_cnt = 0;
       }
-      Serial.print(cw_rx); // send character to the debug serial monitor
-      lcd.print(cw_rx);  // Display the CW character
+      if (!morseCopy.provisional()) {
+        PROFILE(PROF_SERIAL, tel_rx(cw_rx, morseCopy.confidence(), morseCopy.alternative())); // send character to the debug serial port
+      }
+      PROFILE(PROF_LCD, lcd.print(cw_rx));  // Display the CW character
       ++ch_cnt;
     }
-  } while (!(button = lcd.readButtons()));
+    PROFILE(PROF_BUTTONS, button = lcd.readButtons());
+    if (command_poll()) button = BUTTON_SELECT;
+  } while (!button);
 
   while (lcd.readButtons());
 }  // end of morse_decode()
@@ -474,32 +612,16 @@ void paris_test()
 {
   char cw_tx[]= "PARIS";
 
-  // Morse sender parameters
-  byte _speed = prefs[KEY_SPEED] + Key_speed_adj;  // Current speed setting in WPM
-
   boolean done = false;
-  
-  // Setup Speaker for decoder sidetone and encoder output
-  MorseSpeaker Mspkr(beep_pin);
 
-  // Setup Morse sender
-  MorseEncoder morse(key_pin, &Mspkr);
-  switch (prefs[OUT_MODE]) {
-    case 0:  // Digital (key) output
-      Mspkr.outputToneOn = false;
-      break;
-    case 1:  // Analog (beep) output
-      Mspkr.outputToneOn = true;
-      break;
-  }
-  morse.setspeed(_speed);
+  morse_config();
 
   // Loop sending until a button is pressed
   do
   {
-    Serial.print("\nTop of the send loop  ");
     lcd.clear();
     delay(1000);  // one second between each paris
+    tel_event(TEL_SEND, cw_tx, 5);
     
     // Send characters 
     for (int i = 0; i < 5; i++)
@@ -510,11 +632,14 @@ void paris_test()
       }
       lcd.print(cw_tx[i]);  // Display the sent char
       morse.write(cw_tx[i]);   // Send the character
+      PROFILE_LAP_START(PROF_SEND_LOOP);
       do {
-        morse.encode();
+        PROFILE_LAP(PROF_SEND_LOOP);
+        PROFILE(PROF_ENCODE, morse.encode());
+        if (command_poll()) done = true;  // stop after this PARIS
       } while (!morse.available());  // Encoder idle?
 
-      Serial.print(cw_tx[i]); // debug print
+      tel_char(TEL_TX, cw_tx[i]);
     }
   } while (!done);
 
@@ -522,10 +647,135 @@ void paris_test()
 }  // end of paris_test()
 
 
+//=====================================
+// QSO practice. Sends generated on-air style exchanges for copying,
+// one character at a time, until a button is pressed.
+//=====================================
+void qso_practice()
+{
+  QsoGen qso;
+  char cw_tx;
+  byte button;
+  byte ch_cnt = 0;
+  byte width;
+  boolean pausing = false;
+  uint32_t pause_start = 0;
+
+  morse_config();
+  randomSeed(micros());
+  qso.begin();
+
+  lcd.clear();
+  lcd.setCursor(0, 1);
+
+  PROFILE_LAP_START(PROF_SEND_LOOP);
+  do {
+    PROFILE_LAP(PROF_SEND_LOOP);
+    PROFILE(PROF_ENCODE, morse.encode());
+    if (pausing && millis() - pause_start >= 2000) {  // Pause over, start another QSO
+      qso.begin();
+      pausing = false;
+    }
+#ifdef HAL_WAKE_AT
+    if (pausing) HAL_WAKE_AT(pause_start + 2000);
+#endif
+    if (morse.available() && (!pausing || send_text[0])) {  // Encoder idle, feed it the next character
+      cw_tx = send_text[0] ? send_next() : qso.next();  // text from a send command first
+      if (!cw_tx) {  // End of this QSO, pause before the next one
+        pause_start = millis();
+        pausing = true;
+        continue;
+      }
+      width = (cw_tx == MORSE_SK) ? 2 : 1;
+      if (ch_cnt + width > 16) {
+        lcd.setCursor(0,1);
+        lcd.print("                ");
+        lcd.setCursor(0,1);
+        ch_cnt = 0;
+      }
+      morse.write(cw_tx);
+      if (cw_tx == MORSE_SK) PROFILE(PROF_LCD, lcd.print("SK"));
+      else PROFILE(PROF_LCD, lcd.print(cw_tx));
+      PROFILE(PROF_SERIAL, tel_char(TEL_TX, cw_tx));
+      ch_cnt += width;
+    }
+    PROFILE(PROF_BUTTONS, button = lcd.readButtons());
+    if (command_poll()) button = BUTTON_SELECT;
+  } while (!button);
+
+  while (lcd.readButtons());  //wait for button to be released
+}  // end of qso_practice()
+
+
+//===========================
+// Apply the speed and output mode preferences to the
+// Morse engines. Safe to call while they are running.
+//===========================
+void morse_config()
+{
+  byte _speed = prefs[KEY_SPEED] + Key_speed_adj;  // Current speed setting in WPM
+
+  morseCopy.setspeed(_speed);
+  morse.setspeed(_speed);
+  switch (prefs[OUT_MODE]) {
+    case 0:  // Digital (key) output
+      Mspkr.outputEnable(false);
+      break;
+    case 1:  // Analog (beep) output
+      Mspkr.outputEnable(true);
+      break;
+  }
+
+  // Paddles go through the keyer, a straight key straight to the decoder
+  paddles.setspeed(_speed);
+  paddles.setmode(prefs[IN_MODE]);
+  morseInput.setKeyer(prefs[IN_MODE] ? &paddles : NULL);
+  keyer_timer(prefs[IN_MODE] > 0);
+  morseInput.setEarly(prefs[EARLY]);
+}
+
+
+//===========================
+// Paddle keyer clock. Timer1 interrupts every millisecond
+// while a paddle mode is set and steps the keyer, so the
+// elements are timed exactly however busy the loop is.
+//===========================
+void keyer_tick()
+{
+  paddles.tick();
+}
+
+#ifdef __AVR__
+ISR(TIMER1_COMPA_vect)
+{
+  keyer_tick();
+}
+#endif
+
+void keyer_timer(boolean on)
+{
+#ifdef __AVR__
+  noInterrupts();
+  if (on) {
+    TCCR1A = 0;                                    // CTC mode, 16 MHz / 64 / 250 = 1 kHz
+    TCCR1B = _BV(WGM12) | _BV(CS11) | _BV(CS10);
+    OCR1A = 249;
+    TCNT1 = 0;
+    TIMSK1 |= _BV(OCIE1A);
+  } else {
+    TIMSK1 &= ~_BV(OCIE1A);
+  }
+  interrupts();
+#elif defined(HAL_TIMER)
+  HAL_TIMER(on ? 1000 : 0, keyer_tick);
+#endif
+}
+
+
 //===========================
 // Restore app preferences from EEPROM if
 // values are saved, else set to defaults.
-// Send values to serial port on debug. 
+// Values are reported as telemetry.
 //===========================
 void prefs_init()
 {
@@ -535,7 +785,10 @@ void prefs_init()
   {
     for (int idx = 0; idx < NUM_PREFS; idx++)
     {
-      prefs_set(idx,EEPROM.read(idx));
+      // Prefs added since the last save read as erased: use the default
+      if (idx == IN_MODE && EEPROM.read(idx) == 0xFF) prefs_set(IN_MODE, 0);
+      else if (idx == EARLY && EEPROM.read(idx) == 0xFF) prefs_set(EARLY, 1);
+      else prefs_set(idx,EEPROM.read(idx));
     }
   }
   else
@@ -548,6 +801,8 @@ void prefs_init()
     prefs_set(KOCH_NUM, 5);   // Use first 5 char in Koch set
     prefs_set(KOCH_SKIP, 0);  // Don't skip over any char to start
     prefs_set(OUT_MODE, 1);   // Output to speaker
+    prefs_set(IN_MODE, 0);    // Straight key input
+    prefs_set(EARLY, 1);      // Show characters early
   }
 }
 
@@ -555,12 +810,12 @@ void prefs_init()
 //========================
 // Set preference specified in arg1 to value in arg2
 // Constrain prefs values to defined limits
-// Echo value to serial port
+// Report value as telemetry
 //========================
 byte prefs_set(byte pref, int val)
 {
-  const byte lo_lim[] {0, 1, 0, 10, 1, 1, 0, 0};  // Table of lower limits of preference values
-  const byte hi_lim[] {170, 15, 30, 30, 6, 40, 39, 1};  // Table of uppper limits of preference values
+  const byte lo_lim[] {0, 1, 0, 10, 1, 1, 0, 0, 0, 0};  // Table of lower limits of preference values
+  const byte hi_lim[] {170, GROUP_MAX, 30, 30, 7, 40, 39, 1, 2, 1};  // Table of uppper limits of preference values
   byte new_val;
   byte indx;
 
@@ -570,40 +825,165 @@ byte prefs_set(byte pref, int val)
   indx = constrain(pref, 0, NUM_PREFS-1);                // Constrain index, just to be safe
   new_val = constrain(val, lo_lim[indx], hi_lim[indx]);  // Set new value within defined limits
 
-  // Dispatch on preference index to do debug print
-  switch (indx) {
-    case SAVED_FLG:
-      Serial.print("Saved flag = ");
+  // The skip count must leave at least one Koch character
+  if (indx == KOCH_SKIP && new_val >= prefs[KOCH_NUM]) new_val = prefs[KOCH_NUM]-1;
+
+  // Report and save new value before returning it
+  tel_pref(indx, new_val);
+  prefs[indx] = new_val;
+  return new_val;
+}
+
+
+//========================
+// Save all prefs to EEPROM, with the saved flag set
+//========================
+void prefs_save()
+{
+  prefs_set(SAVED_FLG, 170);  // Set prefs saved flag
+  for (int i=0; i<NUM_PREFS; i++) {
+    EEPROM.write(i, prefs[i]);
+  }
+}
+
+
+//========================
+// Serial commands. One per line, each answered by a TEL_REPLY event
+// after any data it asked for:
+//   get [pref]         TEL_PREF for one preference, TEL_PREFS for all
+//   set <pref> <val>   as the prefs menu would, kept until reset unless saved
+//   save               write the preferences to EEPROM
+//   mode <mode>        leave the running mode and start another
+//   stop               leave the running mode for the main menu
+//   send <text>        the trainer's next group, or text for QSO practice;
+//                      one word of characters that have a Morse code
+//   stats [clear]      TEL_STATS for the trainer session, optionally reset
+//   mem                TEL_MEM with the SRAM use and stack high-water mark
+//   profile            TEL_PROFILE table (CW_PROFILE builds only), waits for
+//                      room to send it all, so it is for diagnosis only
+// Prefs go by name or index, modes by name or menu number. The Morse
+// loops call command_poll() every time round, it reads a few bytes at
+// a time and returns true while the running mode has been told to end.
+//========================
+const char cmd_verbs[] PROGMEM = "get set save mode stop send stats mem profile";
+const char cmd_prefs[] PROGMEM = "saved group delay speed charset koch skip out in early";
+const char cmd_modes[] PROGMEM = "menu trainer decoder prefs paris qso";
+
+boolean command_poll()
+{
+  const char *verb;
+  const char *arg;
+  byte status = TEL_OK;
+  int indx;
+  int val;
+  byte data[13];
+
+  // A command's output must fit the transmit buffer as it is, so
+  // the next one waits here, unread, until there is room
+  if (Serial.availableForWrite() < TEL_CMD_ROOM) return stop_mode;
+  if (!cmd_line.poll()) return stop_mode;
+  if (cmd_line.overflow()) {
+    tel_reply(TEL_TOO_LONG, "");
+    return stop_mode;
+  }
+
+  verb = cmd_line.word();
+  switch (CommandLine::find(verb, cmd_verbs)) {
+    case 0:  // get
+      arg = cmd_line.word();
+      if (!*arg) {
+        tel_event(TEL_PREFS, prefs, NUM_PREFS);
+      } else if ((indx = command_arg(arg, cmd_prefs, NUM_PREFS)) >= 0) {
+        tel_pref(indx, prefs[indx]);
+      } else {
+        status = TEL_BAD_ARG;
+      }
       break;
-    case GROUP_NUM:
-      Serial.print("Group size = ");
+    case 1:  // set, not the saved flag
+      indx = command_arg(cmd_line.word(), cmd_prefs, NUM_PREFS);
+      if (indx > SAVED_FLG && CommandLine::number(cmd_line.word(), val)) {
+        prefs_set(indx, val);
+        morse_config();
+      } else {
+        status = TEL_BAD_ARG;
+      }
       break;
-    case GROUP_DLY:
-      Serial.print("Inter-character Delay = ");
-      break; 
-    case KEY_SPEED:
-      Serial.print("Key speed = ");
+    case 2:  // save
+      prefs_save();
       break;
-    case CHAR_SET:
-      Serial.print("Character set = ");
+    case 3:  // mode
+      indx = command_arg(cmd_line.word(), cmd_modes, 6);
+      if (indx >= 0) {
+        next_mode = indx;
+        if (run_mode) stop_mode = true;
+      } else {
+        status = TEL_BAD_ARG;
+      }
+      break;
+    case 4:  // stop
+      if (run_mode) stop_mode = true;
       break;
-    case KOCH_NUM:
-      Serial.print("Koch number = ");
+    case 5:  // send, one group of characters the encoder can key
+      arg = cmd_line.rest();
+      for (indx = 0; arg[indx] && morseEncode(arg[indx]); indx++);
+      if (indx > 0 && indx <= GROUP_MAX && !arg[indx]) {
+        for (indx = 0; arg[indx]; indx++) send_text[indx] = toupper(arg[indx]);
+        send_text[indx] = '\0';
+        send_pos = 0;
+      } else {
+        status = TEL_BAD_ARG;
+      }
+      break;
+    case 6:  // stats
+      arg = cmd_line.word();
+      if (!strcmp(arg, "clear")) {
+        memset(&session, 0, sizeof(session));
+      } else if (*arg) {
+        status = TEL_BAD_ARG;
+        break;
+      }
+      data[0] = run_mode;
+      tel_put16(tel_put16(tel_put16(tel_put16(tel_put16(tel_put16(data + 1,
+        session.rounds), session.perfect), session.chars),
+        session.subs), session.inserts), session.deletes);
+      tel_event(TEL_STATS, data, sizeof(data));
       break;
-    case KOCH_SKIP:
-      if (new_val >= prefs[KOCH_NUM]) new_val = prefs[KOCH_NUM]-1;
-      Serial.print("Skip = ");
+    case 7:  // mem
+      ram_report();
       break;
-    case OUT_MODE:
-      Serial.print("Output mode = ");
+#ifdef CW_PROFILE
+    case 8:  // profile
+      profile_dump();
       break;
+#endif
     default:
-      Serial.print("Preference index out of range\n");
-      return new_val;
+      status = TEL_UNKNOWN;
+      break;
   }
+  tel_reply(status, verb);
+  return stop_mode;
+}
 
-  // Print and save new value before returning it
-  Serial.println(new_val);
-  prefs[indx] = new_val;
-  return new_val;
+
+// Index of a command argument given by name or number, -1 if neither
+int command_arg(const char *arg, const char *names, byte n)
+{
+  int indx = CommandLine::find(arg, names);
+
+  if (indx < 0 && !CommandLine::number(arg, indx)) return -1;
+  return (indx < n) ? indx : -1;
+}
+
+
+// Next character of the send command text. Only called while there
+// is some; the text is cleared once its last character is taken.
+char send_next()
+{
+  char c = send_text[send_pos++];
+
+  if (!send_text[send_pos]) {
+    send_text[0] = '\0';
+    send_pos = 0;
+  }
+  return c;
 }
@@ -0,0 +1,58 @@
+/*          MORSE CODES
+
+ Packed Morse codes, shared by MorseEncoder, MorseDecoder, MorseViterbi
+ and the native tools.
+
+ A code holds the elements of a character as bits, a dot 0 and a dash 1,
+ the first element highest, under a leading 1 that marks the length:
+ E is 0b10, A (.-) is 0b101 and SOS (...---...) is 0b1000111000. The
+ empty code, MORSE_EMPTY, is the 1 on its own, so a receiver adds an
+ element with code * 2 + dash and knows the length from the top bit.
+ A code of up to six elements is the Morse tree node number plus one.
+
+ morseCodes[] gives the code of every character up to '_', indexed by
+ the character, and morseChars[] the character of every code of up to
+ MORSE_TABLE_ELEMENTS elements, indexed by the code. Both are built at
+ compile time from the one list in MorseEnDecoder.cpp, along with a bit
+ per morseChars[] code telling morseStarts() whether a longer code
+ begins with it. The few longer codes, up to MORSE_MAX_ELEMENTS, are
+ kept in a short list of their own, so neither call scans morseCodes[].
+
+ Prosigns take the reserved characters below. AR, BT and KN have the
+ same codes as '+', '=' and '(', and are decoded as those.
+ */
+
+#ifndef MorseCode_H
+#define MorseCode_H
+
+#include <Arduino.h>
+
+typedef uint16_t MorseCode;
+
+#define MORSE_EMPTY 1           // no elements
+#define MORSE_MAX_ELEMENTS 9    // longest code, SOS
+#define MORSE_TABLE_ELEMENTS 6  // longest code in morseChars[]
+#define MORSE_CHARS ('_' + 1)   // entries in morseCodes[]
+
+// Prosigns, sent and received as these characters
+#define MORSE_AR '\x01'         // .-.-.  end of message
+#define MORSE_BT '\x02'         // -...-  break
+#define MORSE_KN '\x03'         // -.--.  go ahead, named station only
+#define MORSE_SK '\x04'         // ...-.- end of contact
+#define MORSE_SOS '\x05'        // ...---...
+
+// The code for a string of dots and dashes, at compile time
+constexpr MorseCode morseCode(const char *elements, MorseCode code = MORSE_EMPTY)
+{
+  return *elements ? morseCode(elements + 1, code * 2 + (*elements == '-')) : code;
+}
+
+extern const MorseCode morseCodes[];  // PROGMEM, by character, 0 if it has none
+extern const char morseChars[];       // PROGMEM, by code, '*' if no character
+
+MorseCode morseEncode(char c);        // 0 if c has no code, lower case is upper cased
+char morseDecode(MorseCode code);     // '*' if code is no character
+byte morseLength(MorseCode code);     // elements in code
+boolean morseStarts(MorseCode code);  // some longer code starts with these elements
+
+#endif
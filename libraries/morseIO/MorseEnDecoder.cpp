@@ -25,18 +25,147 @@
  
  2020/08/19 - Add Class to manage a speaker
             - Add sidetone to decoder and tone output option to encoder.
+ 
+ The native build defines HAL_WAKE_AT(ms) so a simulated clock can skip
+ ahead to the next time decode() or encode() has something to do.
  */ 
 
 #include <avr/pgmspace.h>
 #include "MorseEnDecoder.h"
 
-// Morse code binary tree table (dichotomic search table)
+// Morse codes by character, see MorseCode.h
 // ITU with most punctuation (but without non-english characters - for now)
-const int morseTreeLevels = 6; // Minus top level, also the max nr. of morse signals
-const int morseTableLength = pow(2,morseTreeLevels+1);
-const char morseTable[] PROGMEM = 
-  " ETIANMSURWDKGOHVF*L*PJBXCYZQ!*54*3***2&*+****16=/***(*7***8*90*"
-  "***********?_****\"**.****@***'**-********;!*)*****,****:*******\0";
+#define M(elements) morseCode(elements)
+constexpr MorseCode morseCodes[MORSE_CHARS] PROGMEM = {
+  // Control characters, the prosigns from 1
+  0, M(".-.-."), M("-...-"), M("-.--."), M("...-.-"), M("...---..."), 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  //  space      !             "             #  $              %  &            '
+  0, M("-.-.--"), M(".-..-."), 0, M("...-..-"), 0, M(".-..."), M(".----."),
+  //  (           )             *  +            ,             -             .             /
+  M("-.--."), M("-.--.-"), 0, M(".-.-."), M("--..--"), M("-....-"), M(".-.-.-"), M("-..-."),
+  M("-----"), M(".----"), M("..---"), M("...--"), M("....-"), M("....."), M("-...."), M("--..."),
+  //  8           9            :             ;             <  =           >  ?
+  M("---.."), M("----."), M("---..."), M("-.-.-."), 0, M("-...-"), 0, M("..--.."),
+  //  @            A        B          C          D         E       F          G
+  M(".--.-."), M(".-"), M("-..."), M("-.-."), M("-.."), M("."), M("..-."), M("--."),
+  M("...."), M(".."), M(".---"), M("-.-"), M(".-.."), M("--"), M("-."), M("---"),
+  //  P          Q          R         S         T       U         V          W
+  M(".--."), M("--.-"), M(".-."), M("..."), M("-"), M("..-"), M("...-"), M(".--"),
+  //  X          Y          Z          [  \  ]  ^  _
+  M("-..-"), M("-.--"), M("--.."), 0, 0, 0, 0, M("..--.-"),
+};
+#undef M
+
+// The character with a code, for the table below. Searching down from
+// '_' leaves AR, BT and KN to the punctuation that shares their codes.
+static constexpr char morseCharOf(MorseCode code, int c = MORSE_CHARS - 1)
+{
+  return (c < 0 || code <= MORSE_EMPTY) ? '*'
+       : (morseCodes[c] == code) ? (char)c : morseCharOf(code, c - 1);
+}
+
+// Characters by code, so the decoder goes straight from the elements to
+// the character, built at compile time from morseCodes[]
+#define C4(n) morseCharOf(n), morseCharOf(n + 1), morseCharOf(n + 2), morseCharOf(n + 3)
+#define C16(n) C4(n), C4(n + 4), C4(n + 8), C4(n + 12)
+const char morseChars[2 << MORSE_TABLE_ELEMENTS] PROGMEM = {
+  C16(0), C16(16), C16(32), C16(48), C16(64), C16(80), C16(96), C16(112)
+};
+#undef C4
+#undef C16
+
+static constexpr byte codeLength(MorseCode code)
+{
+  return (code > MORSE_EMPTY) ? 1 + codeLength(code >> 1) : 0;
+}
+
+// Whether some character's code is longer than code and starts with
+// it, for the bits below
+static constexpr bool morseExtends(MorseCode code, int c = MORSE_CHARS - 1)
+{
+  return (c < 0 || code < MORSE_EMPTY) ? false
+       : (codeLength(morseCodes[c]) > codeLength(code) &&
+          (morseCodes[c] >> (codeLength(morseCodes[c]) - codeLength(code))) == code)
+         || morseExtends(code, c - 1);
+}
+
+// One bit per code of morseChars[], set if a longer code starts with it,
+// so the decoder knows at once whether to wait for more elements
+#define E8(n) (morseExtends(n) | morseExtends(n + 1) << 1 | morseExtends(n + 2) << 2 | \
+               morseExtends(n + 3) << 3 | morseExtends(n + 4) << 4 | morseExtends(n + 5) << 5 | \
+               morseExtends(n + 6) << 6 | morseExtends(n + 7) << 7)
+#define E32(n) E8(n), E8(n + 8), E8(n + 16), E8(n + 24)
+static const byte morseExtended[sizeof(morseChars) / 8] PROGMEM = {
+  E32(0), E32(32), E32(64), E32(96)
+};
+#undef E8
+#undef E32
+
+// The k-th character, from '_' down, with a code too long for morseChars[]
+static constexpr char morseLongChar(int k, int c = MORSE_CHARS - 1)
+{
+  return (c < 0) ? 0
+       : (codeLength(morseCodes[c]) <= MORSE_TABLE_ELEMENTS) ? morseLongChar(k, c - 1)
+       : (k == 0) ? (char)c : morseLongChar(k - 1, c - 1);
+}
+
+// Characters with longer codes, so looking them up is a short list
+// rather than all of morseCodes[]
+#define MORSE_LONG_CHARS 2
+static const char morseLongChars[MORSE_LONG_CHARS] PROGMEM = {
+  morseLongChar(0), morseLongChar(1)
+};
+static_assert(morseLongChar(MORSE_LONG_CHARS - 1) && !morseLongChar(MORSE_LONG_CHARS),
+              "MORSE_LONG_CHARS must be the number of codes longer than MORSE_TABLE_ELEMENTS");
+
+MorseCode morseEncode(char c)
+{
+  if (c >= 'a' && c <= 'z') c -= 32;
+  if (c < 0 || c >= MORSE_CHARS) return 0;
+  return pgm_read_word_near(morseCodes + c);
+}
+
+char morseDecode(MorseCode code)
+{
+  if (code < sizeof(morseChars)) return pgm_read_byte_near(morseChars + code);
+  for (byte i = 0; i < MORSE_LONG_CHARS; i++) {
+    char c = pgm_read_byte_near(morseLongChars + i);
+    if (pgm_read_word_near(morseCodes + c) == code) return c;
+  }
+  return '*';
+}
+
+byte morseLength(MorseCode code)
+{
+  byte n = 0;
+  while (code > MORSE_EMPTY) {
+    code >>= 1;
+    n++;
+  }
+  return n;
+}
+
+boolean morseStarts(MorseCode code)
+{
+  if (code < sizeof(morseChars)) return (pgm_read_byte_near(morseExtended + code / 8) >> (code % 8)) & 1;
+  byte n = morseLength(code);
+  for (byte i = 0; i < MORSE_LONG_CHARS; i++) {
+    MorseCode k = pgm_read_word_near(morseCodes + pgm_read_byte_near(morseLongChars + i));
+    byte m = morseLength(k);
+    if (m > n && (k >> (m - n)) == code) return true;
+  }
+  return false;
+}
+
+// Paddle keyer states, see MorseKeyer::tick()
+#define KEYER_IDLE 0
+#define KEYER_MARK 1
+#define KEYER_GAP 2
+
+static byte margin(long x, long nominal, long threshold);
 
 
 /*
@@ -85,6 +214,154 @@ void MorseSpeaker::sideTone(boolean t_on)
 }
 
 
+// Turn encoder output tone on or off while running. A tone that is
+// sounding is stopped first, outputTone() would ignore it once disabled.
+void MorseSpeaker::outputEnable(boolean t_on)
+{
+  if (outputToneOn && !t_on && !keyDown) noTone(spkrOut);
+  outputToneOn = t_on;
+}
+
+
+/*
+  Morse Keyer Class
+    Iambic keyer for a dual lever paddle. Times the elements
+    itself from a 1 ms tick, so they are exact whatever the
+    main loop is doing, and hands them to a MorseDecoder.
+*/
+
+MorseKeyer::MorseKeyer(int dotPin, int dashPin, boolean paddlePullup)
+{
+  dotIn = dotPin;
+  dashIn = dashPin;
+  activeLow = paddlePullup;
+  pinMode(dotIn, INPUT);
+  pinMode(dashIn, INPUT);
+  if (activeLow) {
+    digitalWrite(dotIn, HIGH);
+    digitalWrite(dashIn, HIGH);
+  }
+
+  keyerMode = KEYER_OFF;
+  queueHead = queueTail = 0;
+  setspeed(13);
+  setmode(KEYER_OFF);
+}
+
+
+void MorseKeyer::setspeed(int value)
+{
+  if (value <= 0) value = 1;
+  noInterrupts();
+  dotTicks = 1200 / value;
+  interrupts();
+}
+
+
+// A new mode starts from idle with the key up
+void MorseKeyer::setmode(byte value)
+{
+  noInterrupts();
+  keyerMode = value;
+  state = KEYER_IDLE;
+  element = '\0';
+  dotMemory = dashMemory = false;
+  keyIsDown = false;
+  edgeAge = 0;
+  interrupts();
+}
+
+
+char MorseKeyer::read()
+{
+  if (queueHead == queueTail) return '\0';
+  char temp = queue[queueTail];
+  queueTail = (queueTail + 1) % sizeof(queue);
+  return temp;
+}
+
+
+boolean MorseKeyer::keyDown(unsigned int &since)
+{
+  noInterrupts();
+  boolean down = keyIsDown;
+  since = edgeAge;
+  interrupts();
+  return down;
+}
+
+
+boolean MorseKeyer::busy()
+{
+  return state != KEYER_IDLE || paddle(dotIn) || paddle(dashIn);
+}
+
+
+boolean MorseKeyer::paddle(int pin)
+{
+  return digitalRead(pin) != activeLow;
+}
+
+
+// Called every millisecond. An element is a mark of one dot or three
+// followed by a one dot gap. The other paddle pressed at any time in
+// them is remembered, and at the end of the gap the next element is:
+// the other one if it was remembered or is held, else the same one if
+// its paddle is still held. Squeezing both paddles so alternates dots
+// and dashes. Letting go of both during a mark ends the sequence with
+// that element in mode A; mode B keeps the memory and sends one more.
+void MorseKeyer::tick()
+{
+  if (keyerMode == KEYER_OFF) return;
+  if (edgeAge < 0xFFFF) edgeAge++;
+  boolean dot = paddle(dotIn);
+  boolean dash = paddle(dashIn);
+
+  if (state != KEYER_IDLE) {
+    if (dot && element == '-') dotMemory = true;
+    if (dash && element == '.') dashMemory = true;
+    if (--remaining > 0) return;
+    if (state == KEYER_MARK) {
+      if (keyerMode == KEYER_IAMBIC_A && !dot && !dash) dotMemory = dashMemory = false;
+      state = KEYER_GAP;
+      remaining = dotTicks;
+      keyIsDown = false;
+      edgeAge = 0;
+      return;
+    }
+  }
+
+  // Between elements: pick the next one, dots first from idle
+  char next = '\0';
+  if (element == '.') {
+    if (dashMemory || dash) next = '-';
+    else if (dot) next = '.';
+  } else if (element == '-') {
+    if (dotMemory || dot) next = '.';
+    else if (dash) next = '-';
+  } else {
+    if (dot) next = '.';
+    else if (dash) next = '-';
+  }
+  dotMemory = dashMemory = false;
+  element = next;
+  if (!next) {
+    state = KEYER_IDLE;
+    return;
+  }
+
+  state = KEYER_MARK;
+  remaining = (next == '.') ? dotTicks : 3 * dotTicks;
+  keyIsDown = true;
+  edgeAge = 0;
+  byte head = (queueHead + 1) % sizeof(queue);
+  if (head != queueTail) {
+    queue[queueHead] = next;
+    queueHead = head;
+  }
+}
+
+
 /*
   Morse Decoder Class
     Translates Morse digital signal or tones to a
@@ -105,13 +382,21 @@ MorseDecoder::MorseDecoder(int decodePin, boolean listenAudio, boolean morsePull
 
   // Some initial values  
   wpm = 13;
-  AudioThreshold = 700;
+  AudioThreshold = 0;
+  audioBias = 512L << 8;
+  audioLevel = audioPeak = 0;
+  audioNoise = AGC_START_NOISE;   // falls to the real floor before anything keys
+  agcTime = millis();
+  audioOnset = 0;
   debounceDelay = 20;
   dotTime = 1200 / wpm;       // morse dot time length in ms
   dashTime = 3 * 1200 / wpm;
-  wordSpace = 7 * 1200 / wpm;
+  wordSpace = 13 * 1200 / (2 * wpm);  // a gap this long is between words, see setspeed()
 
-  morseTablePointer = 0;
+  charCode = MORSE_EMPTY;
+  paddles = NULL;
+  external = false;
+  early = false;
  
   morseKeyer = LOW;
   morseSignalState = LOW;
@@ -121,20 +406,36 @@ MorseDecoder::MorseDecoder(int decodePin, boolean listenAudio, boolean morsePull
   gotLastSig = true;
   morseSpace = true;
   decodedMorseChar = '\0';
+  charElements = weakElement = 0;
+  charConfidence = weakConfidence = 100;
+  decodedConfidence = 100;
+  decodedAlternative = '\0';
+  decodedProvisional = decodedReplaces = provisionalShown = false;
   
   lastDebounceTime = 0;
+  keyCount = 0;
+  keySampleTime = keyEdgeTime = 0;
   markTime = 0;
   spaceTime = 0;
 }
 
 
+// Gaps are timed from the key edges themselves (see keyWindow()), not
+// from when the debounce let them through, so a word space is taken
+// from 6.5 dots to leave a quick sender some room under the 7.
 void MorseDecoder::setspeed(int value)
 {
   wpm = value;
   if (wpm <= 0) wpm = 1;
   dotTime = 1200 / wpm;
   dashTime = 3 * 1200 / wpm;
-  wordSpace = 7 * 1200 / wpm;
+  wordSpace = 13 * 1200 / (2 * wpm);
+}
+
+
+void MorseDecoder::setKeyer(MorseKeyer *keyer)
+{
+  paddles = keyer;
 }
 
 
@@ -144,9 +445,76 @@ boolean MorseDecoder::available()
 }
 
 
+byte MorseDecoder::confidence()
+{
+  return decodedConfidence;
+}
+
+
+char MorseDecoder::alternative()
+{
+  return decodedAlternative;
+}
+
+
+// From an outside front end: the key went down (mark) or up at start
+// (ms). decode() takes the key state from these calls from then on.
+void MorseDecoder::edge(boolean mark, MorseTime start)
+{
+  external = true;
+  morseSignalState = mark;
+  if (mark) markTime = start;
+  else spaceTime = start;
+}
+
+
+// Early commit. Normally a character comes out once the gap after it
+// has lasted two dots, since until then another element could follow.
+// With early commit on, a character comes out as soon as its last
+// element is read, half a dot into the gap (with a keyer, as the
+// element starts):
+//  - a character no longer code starts with is final at once
+//  - any other character is provisional: provisional() is true after
+//    it is read, and the next character read, once more elements have
+//    come or the gap has reached two dots, has replaces() true. It may
+//    be the same character, now final, or another provisional one.
+// A display shows a provisional character and overwrites it when the
+// one that replaces it comes; scoring should take final ones only.
+// A sender who carries on past a final character starts a new one.
+void MorseDecoder::setEarly(boolean value)
+{
+  early = value;
+}
+
+
+boolean MorseDecoder::provisional()
+{
+  return decodedProvisional;
+}
+
+
+boolean MorseDecoder::replaces()
+{
+  return decodedReplaces;
+}
+
+
+MorseTime MorseDecoder::markStart()
+{
+  return markTime;
+}
+
+
+MorseTime MorseDecoder::spaceStart()
+{
+  return spaceTime;
+}
+
+
 char MorseDecoder::read()
 {
   char temp = decodedMorseChar;
+  if (temp && decodedProvisional) provisionalShown = true;
   decodedMorseChar = '\0';
   return temp;
 }
@@ -157,37 +525,76 @@ void MorseDecoder::decode()
   currentTime = millis();
   
   // Read Morse signals
-  if (morseAudio == false)
+  if (paddles)
   {
+    // The keyer has timed the elements already, take them as sent
+    unsigned int since;
+    morseKeyer = paddles->keyDown(since);
+    if (morseKeyer != lastKeyerState) MorseSpkr->sideTone(morseKeyer);
+    if (morseKeyer != morseSignalState)
+    {
+      morseSignalState = morseKeyer;
+      if (morseSignalState) markTime = currentTime - since;
+      else spaceTime = currentTime - since;
+    }
+    char element;
+    while ((element = paddles->read()))
+    {
+      if (charCode < (1 << MORSE_MAX_ELEMENTS))
+      {
+        charCode = charCode*2 + (element == '-');
+        if (early) emitEarly();
+      } else { // too many elements in one character
+        badChar();
+      }
+    }
+  }
+  else if (external)
+  {
+    // edge() has set the state and when it began
+  }
+  else if (morseAudio == false)
+  {
+    // Integrate the last reading over the time since it was taken
+    long window = keyWindow();
+    long elapsed = currentTime - keySampleTime;
+    if (elapsed < 0) elapsed = window;  // first read, 2^31 ms or more after the 0 stamp
+    keySampleTime = currentTime;
+    if (lastKeyerState) keyCount = min(keyCount + elapsed, window);
+    else keyCount = max(keyCount - elapsed, 0L);
+
     // Read the Morse keyer (digital)
     morseKeyer = digitalRead(morseInPin);
     if (activeLow) morseKeyer = !morseKeyer;
 
     // If the switch changed, due to noise or pressing:
     if (morseKeyer != lastKeyerState) {
-      lastDebounceTime = currentTime; // reset timer
+      // a change from a settled count may be the start of an edge
+      if (keyCount == (morseSignalState ? window : 0)) keyEdgeTime = currentTime;
       MorseSpkr->sideTone(morseKeyer); // turn sidetone on or off
     }
-    // debounce the morse keyer
-    if ((currentTime - lastDebounceTime) > debounceDelay)
+    // debounce the morse keyer: the count has gone all the way across
+    if (!morseSignalState && keyCount >= window)
     {
-      // whatever the reading is at, it's been there for longer
-      // than the debounce delay, so take it as the actual current state:
-      morseSignalState = morseKeyer;
-      
-      // differentiante mark and space times
-      if (morseSignalState) markTime = lastDebounceTime; 
-      else spaceTime = lastDebounceTime;
+      morseSignalState = true;
+      markTime = keyEdgeTime;
+    }
+    else if (morseSignalState && keyCount <= 0)
+    {
+      morseSignalState = false;
+      spaceTime = keyEdgeTime;
     }
   } else {
     // Read Morse audio signal
     audioSignal = analogRead(morseInPin);
-    if (audioSignal > AudioThreshold)
+    if (audioMark(audioSignal))
     {
       // If this is a new morse signal, reset morse signal timer
-      if (currentTime - lastDebounceTime > dotTime/2)
+      if (currentTime - lastDebounceTime > dotTime/2) audioOnset = currentTime;
+      // and take it as one once it has lasted a quarter dot, like the keyer debounce
+      if (!morseSignalState && currentTime - audioOnset >= dotTime/4)
       {
-        markTime = currentTime;
+        markTime = audioOnset;
         morseSignalState = true; // there is currently a Morse signal
       }
       lastDebounceTime = currentTime;
@@ -204,9 +611,9 @@ void MorseDecoder::decode()
   // Decode morse code
   if (!morseSignalState)
   {
-    if (!gotLastSig)
+    if (!gotLastSig && !paddles)
     {
-      if (morseTablePointer < morseTableLength/2-1)
+      if (charCode < (1 << MORSE_MAX_ELEMENTS))
       {
         // if pause for more than half a dot, get what kind of signal pulse (dot/dash) received last
         if (currentTime - spaceTime > dotTime/2)
@@ -214,42 +621,47 @@ void MorseDecoder::decode()
           // if signal for more than 1/4 dotTime, take it as a morse pulse
           if (spaceTime-markTime > dotTime/4)
           {
-            morseTablePointer *= 2;  // go one level down the tree
+            long mark = spaceTime-markTime;
             // if signal for less than half a dash, take it as a dot
-            if (spaceTime-markTime < dashTime/2)
+            if (mark < dashTime/2)
             {
-               morseTablePointer++; // point to node for a dot
+               charCode = charCode*2; // add a dot
                gotLastSig = true;
+               noteElement(min(margin(mark, dotTime, dashTime/2), margin(mark, dotTime, dotTime/4)), true);
+               if (early) emitEarly();
             }
             // else if signal for between half a dash and a dash + one dot (1.33 dashes), take as a dash
-            else if (spaceTime-markTime < dashTime + dotTime)
+            else if (mark < dashTime + dotTime)
             {
-               morseTablePointer += 2; // point to node for a dash
+               charCode = charCode*2 + 1; // add a dash
                gotLastSig = true;
+               noteElement(min(margin(mark, dashTime, dashTime/2), margin(mark, dashTime, dashTime + dotTime)), true);
+               if (early) emitEarly();
             }
+            // longer still spoils a character in progress
+            else if (charCode > MORSE_EMPTY) badChar();
           }
         }
       } else { // error if too many pulses in one morse character
         //Serial.println("<ERROR: unrecognized signal!>");
-        decodedMorseChar = '#'; // error mark
-        gotLastSig = true;
-        morseTablePointer = 0;
+        badChar();
       }
     }
     // Write out the character if pause is longer than 2/3 dash time (2 dots) and a character received
-    if ((currentTime-spaceTime >= (dotTime*2)) && (morseTablePointer > 0))
-    {
-      decodedMorseChar = pgm_read_byte_near(morseTable + morseTablePointer);
-      morseTablePointer = 0;
-    }
+    if ((currentTime-spaceTime >= (dotTime*2)) && (charCode > MORSE_EMPTY)) emitChar(false);
     // Write a space if pause is longer than wordspace
     if (currentTime-spaceTime > (wordSpace) && morseSpace == false)
     {
       decodedMorseChar = ' ';
+      decodedConfidence = 100;
+      decodedAlternative = '\0';
+      decodedProvisional = decodedReplaces = false;
       morseSpace = true ; // space written-flag
     }
 
   } else {
+    // A new mark ends the gap before it: keep a character together if it was short
+    if (gotLastSig && charCode > MORSE_EMPTY && !paddles) noteElement(margin(markTime-spaceTime, dotTime, dotTime*2), false);
     // while there is a signal, reset some flags
     gotLastSig = false;
     morseSpace = false;
@@ -257,6 +669,159 @@ void MorseDecoder::decode()
   
   // Save the morse keyer state for next round
   lastKeyerState = morseKeyer;
+
+#ifdef HAL_WAKE_AT
+  // Next timing decision, for a simulated clock
+  if (paddles) {
+    if (paddles->busy()) HAL_WAKE_AT(currentTime + 1);  // the keyer moves on every tick
+  } else if (!external && morseAudio == false && morseKeyer != morseSignalState) {
+    HAL_WAKE_AT(currentTime + (morseKeyer ? keyWindow() - keyCount : keyCount));  // the count gets across
+  }
+  if (!morseSignalState)
+  {
+    if (!gotLastSig) HAL_WAKE_AT(spaceTime + dotTime/2 + 1);
+    if (charCode > MORSE_EMPTY) HAL_WAKE_AT(spaceTime + dotTime*2);
+    if (!morseSpace) HAL_WAKE_AT(spaceTime + wordSpace + 1);
+  }
+#endif
+}
+
+
+// How clearly the elements were timed, for confidence(). Every mark
+// and every gap inside a character is scored from 100 at its nominal
+// length down to 0 at the threshold where it would have been read the
+// other way; the character gets the lowest score. Its alternative is
+// the character with its least sure mark read the other way. The gap
+// that ends a character is not scored, it is decided the moment it
+// reaches two dots.
+static byte margin(long x, long nominal, long threshold)
+{
+  long m = 100 * (threshold - x) / (threshold - nominal);
+  if (m < 0) m = 0;
+  if (m > 100) m = 100;
+  return m;
+}
+
+
+void MorseDecoder::noteElement(byte sure, boolean mark)
+{
+  if (sure < charConfidence) charConfidence = sure;
+  if (mark) {
+    if (charElements == 0 || sure < weakConfidence) {
+      weakConfidence = sure;
+      weakElement = charElements;
+    }
+    charElements++;
+  }
+}
+
+
+// Give up on the character being received, and report it as '#'
+void MorseDecoder::badChar()
+{
+  decodedMorseChar = '#'; // error mark
+  decodedConfidence = 0;
+  decodedAlternative = '\0';
+  decodedProvisional = false;
+  decodedReplaces = provisionalShown;
+  provisionalShown = false;
+  gotLastSig = true;
+  charCode = MORSE_EMPTY;
+  charElements = 0;
+  charConfidence = weakConfidence = 100;
+}
+
+
+// Write out the character received so far. A provisional one keeps
+// its elements for the next to build on.
+void MorseDecoder::emitChar(boolean temporary)
+{
+  decodedMorseChar = morseDecode(charCode);
+  decodedConfidence = charConfidence;
+  decodedAlternative = charElements ? flipped(charCode, weakElement) : '\0';
+  decodedProvisional = temporary;
+  decodedReplaces = provisionalShown;
+  provisionalShown = false;
+  if (temporary) return;
+  charCode = MORSE_EMPTY;
+  charElements = 0;
+  charConfidence = weakConfidence = 100;
+}
+
+
+// An element has just been added, see setEarly()
+void MorseDecoder::emitEarly()
+{
+  if (!morseStarts(charCode)) emitChar(false);
+  else if (morseDecode(charCode) != '*') emitChar(true);
+}
+
+
+// The character with one element (0 = the first) of code flipped,
+// '\0' if that is not a character
+char MorseDecoder::flipped(MorseCode code, byte element)
+{
+  byte n = morseLength(code);
+  if (element >= n) return '\0';
+  char c = morseDecode(code ^ (1 << (n - 1 - element)));
+  return (c == '*') ? '\0' : c;
+}
+
+
+// Key debounce. Each decode() adds the time since the last one to a
+// count while the key read closed then, and takes it off while open,
+// between 0 and this window: a quarter dot, but no more than
+// debounceDelay. A mark starts when the count reaches the window and
+// ends when it gets back to 0, so bounce and short glitches average
+// out however fast decode() is called, and the window stays well
+// inside a dot at any speed. Both edges are dated from the reading
+// that first moved the count off its settled end, so the filter
+// delays the decision but not the element times.
+long MorseDecoder::keyWindow()
+{
+  long window = min(dotTime/4, debounceDelay);
+  return (window < 1) ? 1 : window;
+}
+
+
+// Audio AGC, so the decoder needs no level setting. The input is audio
+// on a DC bias: the bias is followed slowly, each sample rectified and
+// the result low passed over about 16 samples into a level that rides
+// over the cycles of the tone and averages most of the noise away.
+// Once a millisecond the signal peak follows the level up quickly and
+// decays with a 0.25 s time constant, so it holds through spaces and
+// follows QSB, and the noise floor follows it down quickly and creeps
+// up, more slowly still during a mark (4 s time constant).
+// A mark starts when the level is halfway from the floor to the peak,
+// but never below twice the floor plus a few counts, and ends halfway
+// back down.
+// A non-zero AudioThreshold skips all this for a fixed level.
+boolean MorseDecoder::audioMark(int sample)
+{
+  if (AudioThreshold > 0) return sample > AudioThreshold;
+
+  long x = (long)sample << 8;
+  audioBias += (x - audioBias) >> 8;
+  long a = x - audioBias;
+  if (a < 0) a = -a;
+  audioLevel += (a - audioLevel) >> 4;
+
+  long elapsed = currentTime - agcTime;
+  if (elapsed > 0) {
+    agcTime = currentTime;
+    if (elapsed > 32) elapsed = 32;   // the filters have settled by then
+    while (elapsed--) {
+      if (audioLevel > audioPeak) audioPeak += (audioLevel - audioPeak) >> 2;
+      else audioPeak -= audioPeak >> 8;
+      if (audioLevel < audioNoise) audioNoise += (audioLevel - audioNoise) >> 5;
+      else audioNoise += (audioLevel - audioNoise) >> (morseSignalState ? 12 : 8);
+    }
+  }
+
+  long threshold = audioNoise + ((audioPeak - audioNoise) >> 1);
+  if (threshold < 2 * audioNoise + AGC_MIN_LEVEL) threshold = 2 * audioNoise + AGC_MIN_LEVEL;
+  if (morseSignalState) threshold = audioNoise + ((threshold - audioNoise) >> 1);
+  return audioLevel > threshold;
 }
 
 
@@ -334,39 +899,15 @@ void MorseEncoder::encode()
 
   if (!sendingMorse && encodeMorseChar)
   {
-    // change to capital letter if not
-    if (encodeMorseChar > 96) encodeMorseChar -= 32;
-  
-    // Scan for the character to send in the Morse table
-    int p;
-    for (p=0; p<morseTableLength+1; p++) if (pgm_read_byte_near(morseTable + p) == encodeMorseChar) break;
-
-    if (p >= morseTableLength) p = 0; // not found, but send a space instead
-
-
-    // Reverse binary tree path tracing
-    int pNode; // parent node
+    // Look up the character to send, lower case as upper
+    MorseCode code = morseEncode(encodeMorseChar);
     morseSignals = 0;
 
-    // Travel the reverse path from position p to the top of the morse table
-    if (p > 0)
+    if (code)
     {
       // build the morse signal (backwards morse signal string from last signal to first)
-      pNode = p;
-      while (pNode > 0)
-      {
-        if ( (pNode & 0x0001) == 1)
-        {
-          // It is a dot
-          morseSignalString[morseSignals++] = '.';
-        } else {
-          // It is a dash
-          morseSignalString[morseSignals++] = '-';
-        }
-        // Find parent node
-        pNode = int((pNode-1)/2);
-      }
-    } else { // Top of Morse tree - Add the top space character
+      for (; code > MORSE_EMPTY; code >>= 1) morseSignalString[morseSignals++] = (code & 1) ? '-' : '.';
+    } else { // not found, send a space instead
       // cheating a little; a wordspace for a "morse signal"
       morseSignalString[morseSignals++] = ' ';
     }
@@ -435,4 +976,18 @@ void MorseEncoder::encode()
       encodeMorseChar = '\0';
     }
   }
+
+#ifdef HAL_WAKE_AT
+  // End of the current signal or pause, for a simulated clock
+  if (sendingMorse)
+  {
+    switch (morseSignalString[sendingMorseSignalNr-1])
+    {
+      case '.': HAL_WAKE_AT(sendMorseTimer + dotTime); break;
+      case '-': HAL_WAKE_AT(sendMorseTimer + dashTime); break;
+      case 'x': HAL_WAKE_AT(sendMorseTimer + (sendingMorseSignalNr > 1 ? dotTime : dashTime)); break;
+      default:  HAL_WAKE_AT(sendMorseTimer + wordSpace - dashTime + 1);
+    }
+  }
+#endif
 }
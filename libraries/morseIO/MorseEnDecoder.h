@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include <pitches.h>
+#include "MorseCode.h"
 
 #define OUTPUT_TONE_PITCH NOTE_A3
 #define SIDE_TONE_PITCH NOTE_C4
@@ -10,6 +11,17 @@
 #define MORSE_KEYER false
 #define MORSE_ACTIVE_LOW true
 #define MORSE_ACTIVE_HIGH false
+#define KEYER_OFF 0
+#define KEYER_IAMBIC_A 1
+#define KEYER_IAMBIC_B 2
+
+// Audio AGC levels, see MorseDecoder::audioMark()
+#define AGC_MIN_LEVEL (2L << 8)     // ADC counts, x256
+#define AGC_START_NOISE (64L << 8)
+
+// A millis() time stamp: a long on the board, and the same 32 bits on a
+// desktop build, where long is 64, so differences wrap the same way
+typedef int32_t MorseTime;
 
 
 class MorseSpeaker
@@ -18,6 +30,7 @@ class MorseSpeaker
     MorseSpeaker(int t_spkrPin);
     void outputTone(boolean t_on);
     void sideTone(boolean t_on);
+    void outputEnable(boolean t_on);
     boolean outputToneOn;
     boolean sideToneOn;
   private:
@@ -27,22 +40,77 @@ class MorseSpeaker
 };
 
 
+class MorseKeyer
+{
+  public:
+    MorseKeyer(int dotPin, int dashPin, boolean paddlePullup);
+    void tick();            // once a millisecond, from a timer interrupt
+    void setspeed(int value);
+    void setmode(byte value);  // KEYER_OFF, KEYER_IAMBIC_A or KEYER_IAMBIC_B
+    char read();            // next element started, '.' or '-', else '\0'
+    boolean keyDown(unsigned int &since);  // key state, and ms since it last changed
+    boolean busy();         // sending, or a paddle is pressed
+  private:
+    boolean paddle(int pin);
+    int dotIn;
+    int dashIn;
+    boolean activeLow;
+    volatile byte keyerMode;
+    volatile int dotTicks;  // dot length in ms
+    volatile byte state;    // idle, mark or the gap after it
+    volatile int remaining; // ms left in the mark or gap
+    volatile char element;  // being sent, '\0' between characters
+    volatile boolean dotMemory;   // dot paddle pressed during a dash
+    volatile boolean dashMemory;  // and the other way round
+    volatile boolean keyIsDown;
+    volatile unsigned int edgeAge;  // ms since keyIsDown changed
+    volatile char queue[8]; // elements started, not yet read
+    volatile byte queueHead;
+    volatile byte queueTail;
+};
+
+
 class MorseDecoder
 {
   public:
     MorseDecoder(int decodePin, boolean listenAudio, boolean morsePullup, MorseSpeaker*);
     void decode();
     void setspeed(int value);
+    void setKeyer(MorseKeyer *keyer);  // take elements from a paddle keyer, NULL for the key input
+    void edge(boolean mark, MorseTime start);  // key state from an outside front end, see the .cpp
+    void setEarly(boolean value);  // emit characters before the gap after them ends, see the .cpp
     char read();
     boolean available();
-    int AudioThreshold;
-    long debounceDelay;     // the debounce time. Keep well below dotTime!!
+    byte confidence();      // 0-100, how clearly the last character's elements were timed
+    char alternative();     // its next best reading, '\0' if none
+    boolean provisional();  // the last character read may still be replaced (early mode)
+    boolean replaces();     // the last character read replaces the provisional one before it
+    MorseTime markStart();  // time (ms) the current or last mark started
+    MorseTime spaceStart(); // time (ms) the current or last space started
+    int AudioThreshold;     // 0 tracks the audio level (default), else a fixed analogRead() level
+    long debounceDelay;     // longest key debounce window, ms; below it the window is a quarter dot
     boolean morseSignalState;  
   private:
     int morseInPin;         // The Morse input pin
     int audioSignal;
+    long audioBias;         // audio AGC, all x256: DC level of the input
+    long audioLevel;        // rectified input, low passed
+    long audioPeak;         // signal level
+    long audioNoise;        // noise floor
+    MorseTime agcTime;      // millis() the slow filters last ran
+    MorseTime audioOnset;   // start of a mark not yet a quarter dot long
+    boolean audioMark(int sample);
+    long keyWindow();
+    void noteElement(byte sure, boolean mark);
+    char flipped(MorseCode code, byte element);
+    void badChar();
+    void emitChar(boolean temporary);
+    void emitEarly();
     MorseSpeaker *MorseSpkr;
-    int morseTablePointer;
+    MorseKeyer *paddles;
+    boolean external;       // key state comes from edge()
+    boolean early;          // early commit, see setEarly()
+    MorseCode charCode;     // elements of the character being received
     int wpm;                // Word-per-minute speed
     long dotTime;           // morse dot time length in ms
     long dashTime;
@@ -53,11 +121,23 @@ class MorseDecoder
     boolean lastKeyerState;
     boolean morseAudio;
     boolean activeLow;
-    long markTime;          // timers for mark and space in morse signal
-    long spaceTime;         // E=MC^2 ;p
-    long lastDebounceTime;  // the last time the input pin was toggled
-    long currentTime;       // The current (signed) time
+    MorseTime markTime;     // timers for mark and space in morse signal
+    MorseTime spaceTime;    // E=MC^2 ;p
+    MorseTime lastDebounceTime; // audio: the last time a mark was heard
+    long keyCount;          // key debounce count, ms, 0 to keyWindow()
+    MorseTime keySampleTime; // when the key was last read
+    MorseTime keyEdgeTime;  // when the key first left its settled state
+    MorseTime currentTime;  // The current (signed) time
     char decodedMorseChar;  // The last decoded Morse character
+    byte charElements;      // elements so far in the character being received
+    byte charConfidence;    // its least sure element
+    byte weakConfidence;    // its least sure mark
+    byte weakElement;       // and which one that was
+    byte decodedConfidence; // for decodedMorseChar
+    char decodedAlternative;
+    boolean decodedProvisional;  // decodedMorseChar may be replaced
+    boolean decodedReplaces;     // decodedMorseChar replaces a provisional one that was read
+    boolean provisionalShown;    // a provisional character has been read and not yet replaced
 };
 
 
@@ -70,7 +150,7 @@ class MorseEncoder
     void write(char temp);
     boolean available();
     int morseSignals;       // nr of morse signals to send in one morse character
-    char morseSignalString[7];// Morse signal for one character as temporary ASCII string of dots and dashes
+    char morseSignalString[MORSE_MAX_ELEMENTS+1];// Morse signal for one character as temporary ASCII string of dots and dashes
   private:
     MorseSpeaker *MorseSpkr;
     char encodeMorseChar;   // ASCII character to encode
@@ -81,9 +161,9 @@ class MorseEncoder
     long wordSpace;
     int morseSignalPos;
     int sendingMorseSignalNr;
-    long sendMorseTimer;
-    long lastDebounceTime;
-    long currentTime;
+    MorseTime sendMorseTimer;
+    MorseTime lastDebounceTime;
+    MorseTime currentTime;
  protected:
     int morseOutPin;
     virtual void setup_signal();
@@ -0,0 +1,428 @@
+/*          MORSE VITERBI DECODER
+
+ A second decoder for untidy keying. MorseDecoder::decode() walks the
+ Morse tree one element at a time with fixed ratios: a mark over 1.5
+ dots is a dash, a space over 2 dots ends the character. One long dot
+ or a stretched gap in a character and the copy is wrong for good.
+
+ MorseViterbi takes the mark and space times from a MorseDecoder, so
+ the keyer debounce and audio AGC are shared, and keeps the best BEAM
+ readings of the elements so far. Each reading is a place in the tree
+ plus the characters it has finished; a mark takes it to both
+ children, a space either stays in the character, ends it, or ends the
+ word. Every choice is scored by how far the time is from the nominal
+ 1, 3 or 7 dots on a log scale, so a dash keyed 2.5 dots long costs
+ little more than one keyed 3, and a reading only finishes a character
+ where the tree has one. The lowest total wins.
+
+ Characters come out once every reading agrees on them, or at the
+ latest LAG characters behind, or when the space grows long enough
+ that only the end of a character makes sense. Each one's confidence
+ is tanh(d/2) of the cost d to the best reading with something else
+ there, which becomes its alternative: 100 when every reading agreed,
+ about 46 when the other is e times less likely. The usual length of a
+ dot, a dash, a gap in a character and a gap between characters each
+ follow the sender, so a heavy or light fist, Farnsworth spacing or a
+ different speed move the thresholds to suit. Word gaps are taken as
+ 7/3 of a character gap.
+
+ RAM is about 2 * BEAM * (LAG + 7) bytes: MorseViterbi<4> fits the
+ ATmega328 comfortably, the native tools use a beam of 32.
+*/
+
+#ifndef MorseViterbi_H
+#define MorseViterbi_H
+
+#include <math.h>
+#include "MorseEnDecoder.h"
+
+#define VITERBI_SIGMA_MARK 0.35   // spread of element lengths, natural log
+#define VITERBI_SIGMA_SPACE 0.5   // spread of gaps, hand keying is looser here
+#define VITERBI_WORD_COST 0.6     // word gaps are rarer than character gaps
+#define VITERBI_LETTER_COST 0.6   // and one letter words rarer still
+#define VITERBI_FLUSH 1.33        // character gaps after which the character is over
+
+template <uint8_t BEAM, uint8_t LAG = 4>
+class MorseViterbi
+{
+  public:
+    MorseViterbi(MorseDecoder *input);
+    void decode();
+    void setspeed(int value);
+    char read();
+    boolean available();
+    byte confidence();        // 0-100 for the last character read
+    char alternative();       // its next best reading, '\0' if none
+    boolean provisional() { return false; }  // every character read is final,
+    boolean replaces() { return false; }     // as MorseDecoder's are without setEarly()
+
+  private:
+    struct Path {
+      float cost;
+      MorseCode code;         // the character so far, MORSE_EMPTY between characters
+      uint8_t len;            // characters in text
+      uint8_t word;           // characters since the last word gap
+      char text[LAG];         // finished but not yet emitted
+    };
+    MorseDecoder *in;
+    Path beam[BEAM];
+    Path next[BEAM];
+    uint8_t paths;
+    float len[4];             // usual dot, dash, element gap and character gap, ms
+    float setUnit;            // dot length from setspeed()
+    boolean lastState;
+    boolean started;          // a mark since the last flush
+    boolean spaceSent;        // or nothing to separate
+    char out[LAG + 4];        // ring of emitted characters
+    uint8_t outConf[LAG + 4]; // and their confidence
+    char outAlt[LAG + 4];     // and alternative
+    uint8_t outHead, outTail;
+    uint8_t lastConf;         // of the character last read
+    char lastAlt;
+    uint8_t word;             // characters emitted since the last space
+
+    static float cost(float d, float units, float sigma);
+    float wordCost(float d, uint8_t letters);
+    boolean wordGap(float d, uint8_t letters);
+    void follow(uint8_t k, float d);
+    static boolean valid(MorseCode code);
+    void reset();
+    void put(char c, uint8_t conf = 100, char alt = '\0');
+    static char charAt(const Path &p, uint8_t j);
+    void emit(uint8_t b, uint8_t j);
+    void offer(const Path &p);
+    void mark(float d);
+    void space(float d);
+    void commit();
+    void flush();
+};
+
+
+template <uint8_t BEAM, uint8_t LAG>
+MorseViterbi<BEAM, LAG>::MorseViterbi(MorseDecoder *input)
+{
+  in = input;
+  outHead = outTail = 0;
+  lastConf = 100;
+  lastAlt = '\0';
+  word = 0;
+  lastState = false;
+  spaceSent = true;
+  setspeed(13);
+}
+
+
+template <uint8_t BEAM, uint8_t LAG>
+void MorseViterbi<BEAM, LAG>::setspeed(int value)
+{
+  in->setspeed(value);
+  if (value <= 0) value = 1;
+  setUnit = 1200.0 / value;
+  len[0] = len[2] = setUnit;
+  len[1] = len[3] = 3 * setUnit;
+  reset();
+}
+
+
+template <uint8_t BEAM, uint8_t LAG>
+boolean MorseViterbi<BEAM, LAG>::available()
+{
+  return outHead != outTail;
+}
+
+
+template <uint8_t BEAM, uint8_t LAG>
+char MorseViterbi<BEAM, LAG>::read()
+{
+  if (outHead == outTail) return '\0';
+  char c = out[outTail];
+  lastConf = outConf[outTail];
+  lastAlt = outAlt[outTail];
+  outTail = (outTail + 1) % sizeof(out);
+  return c;
+}
+
+
+template <uint8_t BEAM, uint8_t LAG>
+byte MorseViterbi<BEAM, LAG>::confidence()
+{
+  return lastConf;
+}
+
+
+template <uint8_t BEAM, uint8_t LAG>
+char MorseViterbi<BEAM, LAG>::alternative()
+{
+  return lastAlt;
+}
+
+
+template <uint8_t BEAM, uint8_t LAG>
+void MorseViterbi<BEAM, LAG>::put(char c, uint8_t conf, char alt)
+{
+  uint8_t n = (outHead + 1) % sizeof(out);
+  if (n == outTail) return;   // reader too slow, drop
+  out[outHead] = c;
+  outConf[outHead] = conf;
+  outAlt[outHead] = alt;
+  outHead = n;
+  word = (c == ' ') ? 0 : word + 1;
+}
+
+
+template <uint8_t BEAM, uint8_t LAG>
+void MorseViterbi<BEAM, LAG>::reset()
+{
+  beam[0].cost = 0;
+  beam[0].code = MORSE_EMPTY;
+  beam[0].len = 0;
+  beam[0].word = word;
+  paths = 1;
+  started = false;
+}
+
+
+// Squared log distance from the nominal length, in units of sigma
+template <uint8_t BEAM, uint8_t LAG>
+float MorseViterbi<BEAM, LAG>::cost(float d, float units, float sigma)
+{
+  if (d < 1) d = 1;
+  float x = log(d / units) / sigma;
+  return x * x / 2;
+}
+
+
+// A space of d ending a word of so many letters
+template <uint8_t BEAM, uint8_t LAG>
+float MorseViterbi<BEAM, LAG>::wordCost(float d, uint8_t letters)
+{
+  float c = cost(d, len[3] * 7 / 3, VITERBI_SIGMA_SPACE) + VITERBI_WORD_COST;
+  return (letters == 1) ? c + VITERBI_LETTER_COST : c;
+}
+
+
+// A space that ends the word rather than the character
+template <uint8_t BEAM, uint8_t LAG>
+boolean MorseViterbi<BEAM, LAG>::wordGap(float d, uint8_t letters)
+{
+  return wordCost(d, letters) < cost(d, len[3], VITERBI_SIGMA_SPACE);
+}
+
+
+// Follow the sender: move len[k] or len[k+1], whichever d is nearer
+// on a log scale, an eighth of the way to d. Dashes and character gaps
+// stay at least twice a dot and an element gap.
+template <uint8_t BEAM, uint8_t LAG>
+void MorseViterbi<BEAM, LAG>::follow(uint8_t k, float d)
+{
+  if (d > len[3] * 3) return;   // a pause, not keying
+  if (d * d > len[k] * len[k + 1]) k++;
+  len[k] += (d - len[k]) / 8;
+  float lo = setUnit / 2, hi = setUnit * 2;
+  if (k & 1) lo *= 3, hi *= 3;
+  if (len[k] < lo) len[k] = lo;
+  if (len[k] > hi) len[k] = hi;
+  k &= 2;
+  if (len[k + 1] < len[k] * 2) len[k + 1] = len[k] * 2;
+}
+
+
+// A code that ends a character
+template <uint8_t BEAM, uint8_t LAG>
+boolean MorseViterbi<BEAM, LAG>::valid(MorseCode code)
+{
+  return code > MORSE_EMPTY && morseDecode(code) != '*';
+}
+
+
+// Keep p in next if it is among the best BEAM so far
+template <uint8_t BEAM, uint8_t LAG>
+void MorseViterbi<BEAM, LAG>::offer(const Path &p)
+{
+  uint8_t i = paths;
+  if (paths < BEAM) paths++;
+  else if (p.cost >= next[BEAM - 1].cost) return;
+  else i = BEAM - 1;
+  while (i > 0 && next[i - 1].cost > p.cost) {
+    next[i] = next[i - 1];
+    i--;
+  }
+  next[i] = p;
+}
+
+
+template <uint8_t BEAM, uint8_t LAG>
+void MorseViterbi<BEAM, LAG>::mark(float d)
+{
+  uint8_t n = paths;
+  paths = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    Path p = beam[i];
+    // Past the table only along the few longer codes
+    if (p.code >= (1 << MORSE_TABLE_ELEMENTS) && !morseStarts(p.code)) continue;
+    MorseCode code = p.code * 2;
+    p.code = code;
+    float c = p.cost;
+    p.cost = c + cost(d, len[0], VITERBI_SIGMA_MARK);
+    offer(p);
+    p.code = code + 1;
+    p.cost = c + cost(d, len[1], VITERBI_SIGMA_MARK);
+    offer(p);
+  }
+  follow(0, d);
+  if (paths == 0) {
+    // Too many elements for any character, as MorseDecoder does
+    for (uint8_t i = 0; i < beam[0].len; i++) put(beam[0].text[i]);
+    put('#', 0);
+    reset();
+    return;
+  }
+  for (uint8_t i = 0; i < paths; i++) beam[i] = next[i];
+}
+
+
+template <uint8_t BEAM, uint8_t LAG>
+void MorseViterbi<BEAM, LAG>::space(float d)
+{
+  uint8_t n = paths;
+  paths = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    Path p = beam[i];
+    float c = p.cost;
+    p.cost = c + cost(d, len[2], VITERBI_SIGMA_SPACE);
+    offer(p);
+    if (!valid(p.code) || p.len > LAG - 2) continue;
+    p.text[p.len++] = morseDecode(p.code);
+    p.code = MORSE_EMPTY;
+    p.word++;
+    p.cost = c + cost(d, len[3], VITERBI_SIGMA_SPACE);
+    offer(p);
+    p.text[p.len++] = ' ';
+    p.cost = c + wordCost(d, p.word);
+    p.word = 0;
+    offer(p);
+  }
+  for (uint8_t i = 0; i < paths; i++) beam[i] = next[i];
+  if (!wordGap(d, 2)) follow(2, d);
+  commit();
+}
+
+
+// Character j of a reading, counting the one it is in the middle of
+template <uint8_t BEAM, uint8_t LAG>
+char MorseViterbi<BEAM, LAG>::charAt(const Path &p, uint8_t j)
+{
+  if (j < p.len) return p.text[j];
+  if (j == p.len && valid(p.code)) return morseDecode(p.code);
+  return '\0';
+}
+
+
+// Put character j of reading b, scored against the best reading that
+// has something else there
+template <uint8_t BEAM, uint8_t LAG>
+void MorseViterbi<BEAM, LAG>::emit(uint8_t b, uint8_t j)
+{
+  char c = charAt(beam[b], j);
+  for (uint8_t i = 0; i < paths; i++) {
+    char alt = charAt(beam[i], j);
+    if (i == b || alt == c) continue;
+    float d = beam[i].cost - beam[b].cost;
+    put(c, (d > 0) ? (uint8_t)(100 * tanh(d / 2) + 0.5) : 0, alt);
+    return;
+  }
+  put(c);
+}
+
+
+// Emit what every reading agrees on, and make room in the best one
+template <uint8_t BEAM, uint8_t LAG>
+void MorseViterbi<BEAM, LAG>::commit()
+{
+  for (;;) {
+    if (beam[0].len == 0) return;
+    char c = beam[0].text[0];
+    boolean agreed = true;
+    for (uint8_t i = 1; i < paths; i++) {
+      if (beam[i].len == 0 || beam[i].text[0] != c) agreed = false;
+    }
+    if (!agreed && beam[0].len < LAG - 1) return;
+
+    // Emit c and drop the readings that disagree
+    emit(0, 0);
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < paths; i++) {
+      if (beam[i].len == 0 || beam[i].text[0] != c) continue;
+      Path &p = beam[kept++];
+      p = beam[i];
+      for (uint8_t j = 1; j < p.len; j++) p.text[j - 1] = p.text[j];
+      p.len--;
+    }
+    paths = kept;
+  }
+}
+
+
+// A long space: the best reading that ends a character wins
+template <uint8_t BEAM, uint8_t LAG>
+void MorseViterbi<BEAM, LAG>::flush()
+{
+  uint8_t best = 0;
+  while (best < paths && !valid(beam[best].code)) best++;
+  if (best == paths) best = 0;
+  Path &p = beam[best];
+  for (uint8_t j = 0; j < p.len; j++) emit(best, j);
+  if (p.code > MORSE_EMPTY) {
+    if (valid(p.code)) emit(best, p.len);
+    else put(morseDecode(p.code), 0);
+  }
+  reset();
+}
+
+
+template <uint8_t BEAM, uint8_t LAG>
+void MorseViterbi<BEAM, LAG>::decode()
+{
+  in->decode();
+  if (in->available()) in->read();   // the tree's copy, not wanted here
+
+  boolean state = in->morseSignalState;
+  MorseTime now = millis();
+  if (state != lastState) {
+    lastState = state;
+    if (state) {
+      // A mark: the space before it ends the character if it was long,
+      // whether or not a poll saw it pass the flush time
+      float d = in->markStart() - in->spaceStart();
+      if (started && d > len[3] * VITERBI_FLUSH) {
+        flush();
+        spaceSent = false;
+      }
+      if (started) {
+        space(d);
+      } else {
+        if (!wordGap(d, word)) follow(2, d);
+        else if (!spaceSent) put(' ');
+      }
+      started = true;
+      spaceSent = true;
+    } else {
+      mark(in->spaceStart() - in->markStart());
+    }
+  }
+  if (!state && started && now - in->spaceStart() > len[3] * VITERBI_FLUSH) {
+    flush();
+    spaceSent = false;
+  }
+  if (!state && !started && !spaceSent && now - in->spaceStart() > len[3] * 7 / 3) {
+    put(' ');
+    spaceSent = true;
+  }
+
+#ifdef HAL_WAKE_AT
+  if (!state && started) HAL_WAKE_AT(in->spaceStart() + (long)(len[3] * VITERBI_FLUSH) + 1);
+  if (!state && !started && !spaceSent) HAL_WAKE_AT(in->spaceStart() + (long)(len[3] * 7 / 3) + 1);
+#endif
+}
+
+#endif
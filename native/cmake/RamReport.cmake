@@ -0,0 +1,96 @@
+# Static RAM per module, run by the ram-report target:
+#   cmake -DSIZE=size -DOBJDUMP=objdump -DOBJECTS="a.o;b.o" -P RamReport.cmake
+#
+# On the AVR, .data, .bss and any constant not marked PROGMEM all take
+# SRAM. The native HAL puts PROGMEM data in its own section, so the sum
+# of the .data, .bss and .rodata sections of each object is its SRAM
+# share. The figures come from the host compiler, where int is 4 bytes
+# and pointers 8 rather than 2, so they overstate the AVR build; use
+# them to compare modules and to spot growth, and the TEL_MEM event
+# from the board for the real numbers.
+
+set(rows "")
+set(total_data 0)
+set(total_bss 0)
+set(total_const 0)
+set(symbols "")
+
+foreach(obj IN LISTS OBJECTS)
+  execute_process(COMMAND ${SIZE} -A ${obj} OUTPUT_VARIABLE out RESULT_VARIABLE rc)
+  if(NOT rc EQUAL 0)
+    message(FATAL_ERROR "${SIZE} failed on ${obj}")
+  endif()
+  set(data 0)
+  set(bss 0)
+  set(const 0)
+  string(REPLACE "\n" ";" lines "${out}")
+  foreach(line IN LISTS lines)
+    if(line MATCHES "^(\\.[a-z_.0-9]+)[ \t]+([0-9]+)")
+      set(sect ${CMAKE_MATCH_1})
+      set(n ${CMAKE_MATCH_2})
+      if(sect MATCHES "^\\.data")
+        math(EXPR data "${data} + ${n}")
+      elseif(sect MATCHES "^\\.bss")
+        math(EXPR bss "${bss} + ${n}")
+      elseif(sect MATCHES "^\\.rodata")
+        math(EXPR const "${const} + ${n}")
+      endif()
+    endif()
+  endforeach()
+  math(EXPR sum "${data} + ${bss} + ${const}")
+  math(EXPR total_data "${total_data} + ${data}")
+  math(EXPR total_bss "${total_bss} + ${bss}")
+  math(EXPR total_const "${total_const} + ${const}")
+
+  get_filename_component(name ${obj} NAME)
+  string(REGEX REPLACE "\\.(cpp|ino\\.cpp)\\.o$" "" name "${name}")
+  if(name STREQUAL "cw-trainer")
+    set(name "cw-trainer.ino")
+  endif()
+  # Sort key first, stripped before printing
+  string(LENGTH "000000${sum}" len)
+  math(EXPR start "${len} - 6")
+  string(SUBSTRING "000000${sum}" ${start} 6 key)
+  set(label "${name}")
+  string(LENGTH "${label}" nlen)
+  while(nlen LESS 24)
+    string(APPEND label " ")
+    math(EXPR nlen "${nlen} + 1")
+  endwhile()
+  list(APPEND rows "${key}|${label}${data}\t${bss}\t${const}\t${sum}")
+
+  # The biggest variables, data and bss only
+  execute_process(COMMAND ${OBJDUMP} -t -C ${obj} OUTPUT_VARIABLE out)
+  string(REPLACE "\n" ";" lines "${out}")
+  foreach(line IN LISTS lines)
+    if(line MATCHES " O \\.(data|bss)[^ \t]*[ \t]+([0-9a-f]+) (.*)$")
+      math(EXPR n "0x${CMAKE_MATCH_2}")
+      string(LENGTH "000000${n}" len)
+      math(EXPR start "${len} - 6")
+      string(SUBSTRING "000000${n}" ${start} 6 key)
+      list(APPEND symbols "${key}|${n}\t${CMAKE_MATCH_3} (${name})")
+    endif()
+  endforeach()
+endforeach()
+
+list(SORT rows ORDER DESCENDING)
+list(SORT symbols ORDER DESCENDING)
+
+message("Static RAM by module, bytes on the native build (see native/cmake/RamReport.cmake)")
+message("module                  data\tbss\tconst\ttotal")
+foreach(row IN LISTS rows)
+  string(REGEX REPLACE "^[0-9]+\\|" "" row "${row}")
+  message("${row}")
+endforeach()
+math(EXPR total "${total_data} + ${total_bss} + ${total_const}")
+message("total                   ${total_data}\t${total_bss}\t${total_const}\t${total}")
+message("")
+message("Largest variables")
+list(LENGTH symbols nsym)
+if(nsym GREATER 12)
+  list(SUBLIST symbols 0 12 symbols)
+endif()
+foreach(sym IN LISTS symbols)
+  string(REGEX REPLACE "^[0-9]+\\|" "" sym "${sym}")
+  message("  ${sym}")
+endforeach()
@@ -0,0 +1,26 @@
+# Turn an Arduino .ino file into a C++ translation unit.
+#
+# The Arduino IDE adds Arduino.h and a prototype for every function in
+# the sketch before compiling it. arduino_sketch_source() does the same
+# at configure time: top level lines of the form "type name(args)" with
+# no semicolon become prototypes, and the .ino is included unchanged.
+
+function(arduino_sketch_source ino out)
+  file(STRINGS "${ino}" lines)
+  set(protos "")
+  foreach(line IN LISTS lines)
+    if(line MATCHES "^([A-Za-z_][A-Za-z0-9_]*[ \t*&]+)+[A-Za-z_][A-Za-z0-9_]*[ \t]*\\([^;{}]*\\)[ \t]*(//.*)?$"
+       AND NOT line MATCHES "^(return|else|if|while|for|switch)[ \t(]")
+      string(REGEX MATCH "^[^)]*\\)" proto "${line}")
+      string(APPEND protos "${proto};\n")
+    endif()
+  endforeach()
+
+  file(WRITE "${out}.tmp"
+    "// Generated from ${ino} by native/cmake/Sketch.cmake\n"
+    "#include <Arduino.h>\n\n"
+    "${protos}\n"
+    "#include \"${ino}\"\n")
+  configure_file("${out}.tmp" "${out}" COPYONLY)
+  set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS "${ino}")
+endfunction()
@@ -0,0 +1,102 @@
+/****************************************
+  MorseDecoder's audio front end, vectorised for the host.
+  See envelope.h for a description.
+
+  The scalar and SSE2 kernels are built here. The AVX2 one is in
+  envelope_avx2.cpp, the only file built for AVX2, and is used when
+  the processor has it.
+*****************************************/
+
+#include <string.h>
+
+#include <stdexcept>
+#include <string>
+
+#include "envelope.h"
+#include "envelope_kernel.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+
+struct Sse2Lanes {
+  typedef __m128i v;
+  static const unsigned N = 4;
+  static v load(const int32_t *p) { return _mm_loadu_si128((const __m128i *)p); }
+  static void store(int32_t *p, v a) { _mm_storeu_si128((__m128i *)p, a); }
+  static v set1(int32_t x) { return _mm_set1_epi32(x); }
+  static v add(v a, v b) { return _mm_add_epi32(a, b); }
+  static v sub(v a, v b) { return _mm_sub_epi32(a, b); }
+  template <int S> static v sra(v a) { return _mm_srai_epi32(a, S); }
+  template <int S> static v sll(v a) { return _mm_slli_epi32(a, S); }
+  static v gt(v a, v b) { return _mm_cmpgt_epi32(a, b); }
+  static v and_(v a, v b) { return _mm_and_si128(a, b); }
+  static v or_(v a, v b) { return _mm_or_si128(a, b); }
+  static v andnot(v m, v a) { return _mm_andnot_si128(m, a); }
+  static v select(v m, v a, v b) { return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b)); }
+  static v abs(v a)
+  {
+    v s = _mm_srai_epi32(a, 31);   // SSE2 has no abs, so (a ^ s) - s
+    return _mm_sub_epi32(_mm_xor_si128(a, s), s);
+  }
+  static unsigned bits(v m) { return _mm_movemask_ps(_mm_castsi128_ps(m)); }
+};
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+void envelope_run_avx2(const EnvelopeJob &job);   // envelope_avx2.cpp
+static const unsigned avx2_lanes = 8;
+#endif
+
+std::vector<const char *> audio_edges_isas()
+{
+  std::vector<const char *> isas;
+#if defined(__x86_64__) || defined(__i386__)
+  if (__builtin_cpu_supports("avx2")) isas.push_back("avx2");
+#endif
+#if defined(__SSE2__)
+  isas.push_back("sse2");
+#endif
+  isas.push_back("scalar");
+  return isas;
+}
+
+static void add_edge(void *ctx, unsigned lane, const AudioEdge &e)
+{
+  static_cast<std::vector<AudioEdge> *>(ctx)[lane].push_back(e);
+}
+
+std::vector<std::vector<AudioEdge>> audio_edges(const std::vector<AudioInput> &in, unsigned rate,
+                                                uint64_t start_us, size_t length, const char *isa)
+{
+  if (!isa) isa = audio_edges_isas()[0];
+  void (*run)(const EnvelopeJob &) = NULL;
+  unsigned lanes = 1;
+  if (!strcmp(isa, "scalar")) {
+    run = envelope_run<ScalarLanes>;
+#if defined(__SSE2__)
+  } else if (!strcmp(isa, "sse2")) {
+    run = envelope_run<Sse2Lanes>;
+    lanes = Sse2Lanes::N;
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+  } else if (!strcmp(isa, "avx2") && __builtin_cpu_supports("avx2")) {
+    run = envelope_run_avx2;
+    lanes = avx2_lanes;
+#endif
+  }
+  if (!run) throw std::invalid_argument(std::string("audio_edges: no ") + isa + " kernel here");
+
+  std::vector<std::vector<AudioEdge>> out(in.size());
+  for (size_t i = 0; i < in.size(); i += lanes) {
+    EnvelopeJob job;
+    job.in = &in[i];
+    job.lanes = (in.size() - i < lanes) ? in.size() - i : lanes;
+    job.rate = rate;
+    job.startUs = start_us;
+    job.length = length;
+    job.edge = add_edge;
+    job.ctx = &out[i];
+    run(job);
+  }
+  return out;
+}
@@ -0,0 +1,65 @@
+/****************************************
+  MorseDecoder's audio front end, vectorised for decoding hours of
+  recorded audio on the host.
+
+  In audio mode every decode() call reads one sample and runs it
+  through audioMark() (bias removal, rectification, a low pass, and a
+  peak and noise floor follower stepped once a millisecond, with a
+  threshold between them) and then through the rules that make key
+  edges of the result: a mark must last a quarter dot, and a space
+  half a dot. Polled once per sample through the HAL that is the hot
+  path when copying a recording.
+
+  audio_edges() runs the same integer arithmetic on several recordings
+  at once, one per SIMD lane: 8 with AVX2, 4 with SSE2, else one at a
+  time. The filters are recursive, so it is recordings and not samples
+  that go side by side. Each recording gives exactly the edges
+  MorseDecoder would have found polled once per sample, and
+  MorseDecoder::edge() takes them in: decoder_regress checks both for
+  every audio fixture and every instruction set the machine has.
+
+  Sample k of every recording is read at start + k * 1000000 / rate us,
+  on a decoder made at start, and scaled to 10 bit ADC counts on a 512
+  bias like the HAL's analog input. Recordings shorter than length run
+  on in silence.
+*****************************************/
+
+#ifndef envelope_h
+#define envelope_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+struct AudioInput {
+  const int16_t *pcm;
+  size_t samples;
+  int wpm;                    // MorseDecoder::setspeed()
+};
+
+struct AudioEdge {
+  uint64_t at;                // us, the sample MorseDecoder would have seen it at
+  long start;                 // ms, its markStart() or spaceStart()
+  bool mark;
+};
+
+inline bool operator==(const AudioEdge &a, const AudioEdge &b)
+{
+  return a.at == b.at && a.start == b.start && a.mark == b.mark;
+}
+
+// The edges of every input, with the best instruction set or the one
+// named ("avx2", "sse2" or "scalar", NULL for the best)
+std::vector<std::vector<AudioEdge>> audio_edges(const std::vector<AudioInput> &in, unsigned rate,
+                                                uint64_t start_us, size_t length, const char *isa = NULL);
+
+// Instruction sets this machine can run, best first
+std::vector<const char *> audio_edges_isas();
+
+// The HAL's analog input model: 16 bit PCM to ADC counts
+inline int pcm_to_adc(int16_t s)
+{
+  return 512 + s * 511 / 32767;
+}
+
+#endif
@@ -0,0 +1,33 @@
+/****************************************
+  The AVX2 audio_edges() kernel, eight recordings at a time. This file
+  alone is built with -mavx2; envelope.cpp only calls it after checking
+  the processor. See envelope.h for a description.
+*****************************************/
+
+#include <immintrin.h>
+
+#include "envelope_kernel.h"
+
+struct Avx2Lanes {
+  typedef __m256i v;
+  static const unsigned N = 8;
+  static v load(const int32_t *p) { return _mm256_loadu_si256((const __m256i *)p); }
+  static void store(int32_t *p, v a) { _mm256_storeu_si256((__m256i *)p, a); }
+  static v set1(int32_t x) { return _mm256_set1_epi32(x); }
+  static v add(v a, v b) { return _mm256_add_epi32(a, b); }
+  static v sub(v a, v b) { return _mm256_sub_epi32(a, b); }
+  template <int S> static v sra(v a) { return _mm256_srai_epi32(a, S); }
+  template <int S> static v sll(v a) { return _mm256_slli_epi32(a, S); }
+  static v gt(v a, v b) { return _mm256_cmpgt_epi32(a, b); }
+  static v and_(v a, v b) { return _mm256_and_si256(a, b); }
+  static v or_(v a, v b) { return _mm256_or_si256(a, b); }
+  static v andnot(v m, v a) { return _mm256_andnot_si256(m, a); }
+  static v select(v m, v a, v b) { return _mm256_blendv_epi8(b, a, m); }
+  static v abs(v a) { return _mm256_abs_epi32(a); }
+  static unsigned bits(v m) { return _mm256_movemask_ps(_mm256_castsi256_ps(m)); }
+};
+
+void envelope_run_avx2(const EnvelopeJob &job)
+{
+  envelope_run<Avx2Lanes>(job);
+}
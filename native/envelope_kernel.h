@@ -0,0 +1,156 @@
+/****************************************
+  The audio_edges() kernel, written once over a lane type so the same
+  steps build for AVX2, SSE2 and plain integers. See envelope.h.
+
+  A lane type V has N lanes of int32 and the few operations below; a
+  mask is a lane of all ones or zeros. Every step mirrors a line of
+  MorseDecoder::audioMark() or the audio branch of decode().
+
+  Edges go out through a callback rather than into a std::vector, so
+  the AVX2 build instantiates no library templates that the linker
+  could pick over the plain ones.
+*****************************************/
+
+#ifndef envelope_kernel_h
+#define envelope_kernel_h
+
+#include "MorseEnDecoder.h"
+#include "envelope.h"
+
+struct EnvelopeJob {
+  const AudioInput *in;       // lanes inputs
+  unsigned lanes;
+  unsigned rate;
+  uint64_t startUs;
+  size_t length;
+  void (*edge)(void *ctx, unsigned lane, const AudioEdge &e);
+  void *ctx;
+};
+
+// Plain integers, one lane
+struct ScalarLanes {
+  typedef int32_t v;
+  static const unsigned N = 1;
+  static v load(const int32_t *p) { return *p; }
+  static void store(int32_t *p, v a) { *p = a; }
+  static v set1(int32_t x) { return x; }
+  static v add(v a, v b) { return a + b; }
+  static v sub(v a, v b) { return a - b; }
+  template <int S> static v sra(v a) { return a >> S; }
+  template <int S> static v sll(v a) { return (int32_t)((uint32_t)a << S); }
+  static v gt(v a, v b) { return -(int32_t)(a > b); }
+  static v and_(v a, v b) { return a & b; }
+  static v or_(v a, v b) { return a | b; }
+  static v andnot(v m, v a) { return ~m & a; }
+  static v select(v m, v a, v b) { return (m & a) | (~m & b); }
+  static v abs(v a) { return a < 0 ? -a : a; }
+  static unsigned bits(v m) { return m & 1; }
+};
+
+template <class V>
+static void envelope_run(const EnvelopeJob &job)
+{
+  typedef typename V::v v;
+  const unsigned N = V::N;
+  const size_t block = 256;
+  int32_t buf[block * N];
+  int32_t lane[N];
+
+  // Per lane timing, from setspeed()
+  int32_t half[N], quarter[N];
+  for (unsigned i = 0; i < N; i++) {
+    int wpm = (i < job.lanes) ? job.in[i].wpm : 20;
+    if (wpm <= 0) wpm = 1;
+    long dot = 1200 / wpm;
+    half[i] = dot / 2;
+    quarter[i] = dot / 4;
+  }
+  v vHalf = V::load(half), vQuarter1 = V::sub(V::load(quarter), V::set1(1));
+
+  // As the MorseDecoder constructor leaves them
+  v bias = V::set1(512L << 8), level = V::set1(0), peak = V::set1(0);
+  v noise = V::set1(AGC_START_NOISE);
+  v state = V::set1(0), onset = V::set1(0), lastDeb = V::set1(0);
+  int32_t agcMs = job.startUs / 1000;
+  const v minLevel = V::set1(AGC_MIN_LEVEL), bias512 = V::set1(512), one = V::set1(1);
+
+  for (size_t k0 = 0; k0 < job.length; k0 += block) {
+    size_t n = (job.length - k0 < block) ? job.length - k0 : block;
+
+    // Side by side, lane i of sample k at buf[k * N + i]
+    for (unsigned i = 0; i < N; i++) {
+      const AudioInput *in = (i < job.lanes) ? &job.in[i] : NULL;
+      size_t have = (in && in->samples > k0) ? in->samples - k0 : 0;
+      if (have > n) have = n;
+      for (size_t k = 0; k < have; k++) buf[k * N + i] = in->pcm[k0 + k];
+      for (size_t k = have; k < n; k++) buf[k * N + i] = 0;
+    }
+    // PCM to ADC counts, x256: s * 511 / 32767 rounded toward zero,
+    // from (a + (a >> 15) + 1) >> 15, exact for every 16 bit a / 32767
+    for (size_t k = 0; k < n; k++) {
+      v s = V::load(&buf[k * N]);
+      v a = V::sub(V::template sll<9>(s), s);
+      v sign = V::template sra<31>(a);
+      v m = V::abs(a);
+      v q = V::template sra<15>(V::add(V::add(m, V::template sra<15>(m)), one));
+      q = V::select(sign, V::sub(V::set1(0), q), q);
+      V::store(&buf[k * N], V::template sll<8>(V::add(q, bias512)));
+    }
+
+    for (size_t k = 0; k < n; k++) {
+      uint64_t at = job.startUs + (k0 + k) * 1000000 / job.rate;
+      int32_t ms = at / 1000;
+      v x = V::load(&buf[k * N]);
+
+      // Bias, rectify, low pass
+      bias = V::add(bias, V::template sra<8>(V::sub(x, bias)));
+      v a = V::abs(V::sub(x, bias));
+      level = V::add(level, V::template sra<4>(V::sub(a, level)));
+
+      // Peak and noise floor, once a millisecond for every lane
+      if (ms > agcMs) {
+        int32_t elapsed = ms - agcMs;
+        agcMs = ms;
+        if (elapsed > 32) elapsed = 32;
+        while (elapsed--) {
+          v up = V::gt(level, peak);
+          peak = V::select(up, V::add(peak, V::template sra<2>(V::sub(level, peak))),
+                           V::sub(peak, V::template sra<8>(peak)));
+          v d = V::sub(level, noise);
+          v down = V::gt(noise, level);
+          v creep = V::select(state, V::template sra<12>(d), V::template sra<8>(d));
+          noise = V::add(noise, V::select(down, V::template sra<5>(d), creep));
+        }
+      }
+
+      // Threshold, halfway down again during a mark
+      v th = V::add(noise, V::template sra<1>(V::sub(peak, noise)));
+      v least = V::add(V::add(noise, noise), minLevel);
+      th = V::select(V::gt(least, th), least, th);
+      th = V::select(state, V::add(noise, V::template sra<1>(V::sub(th, noise))), th);
+      v mark = V::gt(level, th);
+
+      // decode(): a mark starts once a quarter dot long, a space once
+      // half a dot long
+      v vMs = V::set1(ms);
+      v since = V::sub(vMs, lastDeb);
+      v gap = V::gt(since, vHalf);
+      onset = V::select(V::and_(mark, gap), vMs, onset);
+      v start = V::and_(V::andnot(state, mark), V::gt(V::sub(vMs, onset), vQuarter1));
+      v end = V::and_(V::andnot(mark, state), gap);
+      unsigned edges = V::bits(V::or_(start, end));
+      if (edges) {
+        v from = V::select(start, onset, lastDeb);
+        V::store(lane, from);
+        unsigned starts = V::bits(start);
+        for (unsigned i = 0; i < job.lanes; i++) {
+          if (edges & (1u << i)) job.edge(job.ctx, i, AudioEdge{at, lane[i], (starts & (1u << i)) != 0});
+        }
+      }
+      lastDeb = V::select(mark, vMs, lastDeb);
+      state = V::andnot(end, V::or_(state, start));
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,128 @@
+/****************************************
+  Native Arduino core shim.
+
+  Just enough of the Arduino AVR core for the CW Trainer sketch and its
+  libraries to build and run on a desktop. All hardware state (pins,
+  clock, EEPROM, serial buffers, the LCD shield) lives in a per-thread
+  HAL instance, see ArduinoHal.h for the controls a test harness uses.
+*****************************************/
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <ctype.h>   // WCharacter.h brings it in on the AVR core
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <type_traits>
+
+#include <avr/pgmspace.h>
+#include <avr/interrupt.h>
+
+#ifndef ARDUINO
+#define ARDUINO 10813
+#endif
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef unsigned int word;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+#define NOT_AN_INTERRUPT -1
+
+#define PI 3.1415926535897932384626433832795
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define NUM_DIGITAL_PINS 64   // generous, harnesses use spare pins as virtual inputs
+#define NUM_ANALOG_INPUTS 8
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+
+// The AVR core defines these as macros. Templates give the same mixed
+// type behaviour without breaking the C++ standard headers. They return
+// by value: with both arguments the same type the ?: is an lvalue, and
+// a reference to a parameter would dangle.
+template<class A, class B> inline auto min(A a, B b) -> typename std::decay<decltype(a < b ? a : b)>::type { return (a < b) ? a : b; }
+template<class A, class B> inline auto max(A a, B b) -> typename std::decay<decltype(a > b ? a : b)>::type { return (a > b) ? a : b; }
+template<class T, class L, class H> inline T constrain(T x, L lo, H hi)
+{
+  return (x < lo) ? T(lo) : ((x > hi) ? T(hi) : x);
+}
+#define sq(x) ((x)*(x))
+#define radians(deg) ((deg)*DEG_TO_RAD)
+#define degrees(rad) ((rad)*RAD_TO_DEG)
+
+#define lowByte(w) ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+
+#define digitalPinToInterrupt(p) ((p) == 2 ? 0 : ((p) == 3 ? 1 : NOT_AN_INTERRUPT))
+
+// Digital and analog I/O
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration = 0);
+void noTone(uint8_t pin);
+
+// Time
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield(void);
+
+// Native only: tell the virtual clock that the caller has nothing to do
+// until millis() reaches ms. Libraries guard their calls with
+// #ifdef HAL_WAKE_AT so the AVR build is unchanged.
+#define HAL_WAKE_AT(ms) hal_wake_at(ms)
+void hal_wake_at(unsigned long ms);
+
+// Native only: call isr every period_us, in place of a hardware timer
+// interrupt; a NULL isr stops it. The handler runs between the sketch's
+// HAL calls, never inside one, and waits while interrupts are off.
+// Sketches guard their calls with #ifdef HAL_TIMER.
+#define HAL_TIMER(period_us, isr) hal_timer(period_us, isr)
+void hal_timer(unsigned long period_us, void (*isr)(void));
+
+// Interrupts
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode);
+void detachInterrupt(uint8_t interruptNum);
+void interrupts(void);
+void noInterrupts(void);
+
+// Random numbers. Overloads sit beside the C library's random(void).
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+void setup(void);
+void loop(void);
+
+#include "HardwareSerial.h"
+
+#endif
@@ -0,0 +1,93 @@
+/****************************************
+  Native HAL controls.
+
+  The Arduino shim (Arduino.h, Wire.h, EEPROM.h, ...) runs against a
+  model of the trainer hardware: digital and analog pins, the speaker
+  tone, EEPROM, the serial port and the Adafruit RGB LCD shield. These
+  functions let a host program drive and inspect that model.
+
+  Every thread has its own instance, so a multi-threaded tool can run
+  one sketch, decoder or encoder per worker without locking.
+*****************************************/
+
+#ifndef ArduinoHal_h
+#define ArduinoHal_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <functional>
+#include <string>
+
+namespace hal {
+
+// Back to power-on state: pins floating, EEPROM erased, LCD blank,
+// clock at zero, listeners and hooks removed.
+void reset();
+
+// Clock, in microseconds since reset(). Real time by default.
+uint64_t now_us();
+
+// Virtual time. The clock only moves when the sketch waits: delay()
+// jumps ahead, and once the sketch has polled SIM_IDLE_POLLS times with
+// nothing changing, its next millis()/micros() call jumps the clock to
+// the earliest of the next scheduled event and the next wake hint (see
+// hal_wake_at() in Arduino.h). Each poll also costs poll_cost_us, so
+// busy loops still see time pass. max_step_us > 0 caps every jump, for inputs that need
+// regular sampling such as audio.
+const unsigned SIM_IDLE_POLLS = 64;
+void set_virtual_time(uint64_t start_us, unsigned poll_cost_us = 1, uint64_t max_step_us = 0);
+bool virtual_time();
+void schedule(uint64_t t_us, std::function<void()> event);  // run event when the clock reaches t_us
+void set_end_time(uint64_t t_us);                           // throw SimulationEnd at t_us
+
+// Thrown out of the sketch when the end time is reached, or when
+// nothing is scheduled and nothing could ever wake the sketch again.
+struct SimulationEnd {
+  bool idle;  // true if stopped because nothing was left to happen
+};
+
+struct SimStats {
+  uint64_t polls;    // HAL polls by the sketch
+  uint64_t jumps;    // idle clock jumps
+  uint64_t events;   // scheduled events run
+};
+SimStats sim_stats();
+
+// Called from every HAL entry point that polls time or inputs (millis,
+// digitalRead, Wire reads, ...). Lets a harness feed inputs while the
+// sketch sits in a busy loop.
+void set_service_hook(std::function<void()> hook);
+
+// Digital inputs. An undriven input reads HIGH with the pullup on and
+// LOW without. Driving an input runs any interrupt attached to it.
+void set_input(uint8_t pin, bool level);
+void release_input(uint8_t pin);
+
+// Analog inputs: a fixed value, or a source asked on every analogRead.
+void set_analog(uint8_t pin, int value);
+void set_analog_source(std::function<int(uint8_t pin, uint64_t t_us)> source);
+
+// Outputs
+int output_level(uint8_t pin);         // last digitalWrite, -1 if never written
+unsigned tone_frequency(uint8_t pin);  // 0 when silent
+void on_output(std::function<void(uint8_t pin, int level, uint64_t t_us)> listener);
+void on_tone(std::function<void(uint8_t pin, unsigned freq, uint64_t t_us)> listener);
+
+// Serial port. Output goes to stdout unless a sink is set.
+void serial_input(const char *data, size_t len);
+void set_serial_sink(std::function<void(const uint8_t *data, size_t len)> sink);
+unsigned long serial_baud();
+
+// EEPROM contents (EEPROM_SIZE bytes)
+const size_t EEPROM_SIZE = 1024;
+uint8_t *eeprom();
+
+// LCD shield
+void press_buttons(uint8_t mask);      // BUTTON_* bits held down, 0 releases
+std::string lcd_line(int row);         // 16 visible characters of row 0 or 1
+uint8_t lcd_backlight();               // RED, GREEN, ... bits as given to setBacklight()
+void on_lcd_change(std::function<void()> listener);
+
+}  // namespace hal
+
+#endif
@@ -0,0 +1,22 @@
+/****************************************
+  Native EEPROM library. 1 KB, erased to 0xFF, kept in the HAL so a
+  harness can preload or inspect it (see ArduinoHal.h).
+*****************************************/
+
+#ifndef EEPROM_h
+#define EEPROM_h
+
+#include <stdint.h>
+
+class EEPROMClass
+{
+  public:
+    uint8_t read(int idx);
+    void write(int idx, uint8_t val);
+    void update(int idx, uint8_t val);
+    uint16_t length();
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,33 @@
+/****************************************
+  Native HardwareSerial. Output goes to the HAL's serial sink (stdout
+  unless a harness replaces it). The 64 byte transmit buffer drains at
+  the configured baud rate against the HAL clock, so a full buffer
+  blocks the caller just as it does on the AVR.
+*****************************************/
+
+#ifndef HardwareSerial_h
+#define HardwareSerial_h
+
+#include "Print.h"
+
+#define SERIAL_TX_BUFFER_SIZE 64
+#define SERIAL_RX_BUFFER_SIZE 64
+
+class HardwareSerial : public Print
+{
+  public:
+    void begin(unsigned long baud);
+    void end();
+    int available(void);
+    int peek(void);
+    int read(void);
+    int availableForWrite(void);
+    void flush(void);
+    size_t write(uint8_t);
+    using Print::write;
+    operator bool() { return true; }
+};
+
+extern HardwareSerial Serial;
+
+#endif
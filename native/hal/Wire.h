@@ -0,0 +1,34 @@
+/****************************************
+  Native TwoWire (I2C master). Transactions are handed to the devices
+  attached to the HAL bus; the Adafruit RGB LCD shield's MCP23017 is
+  always present at 0x20.
+*****************************************/
+
+#ifndef TwoWire_h
+#define TwoWire_h
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BUFFER_LENGTH 32
+
+class TwoWire
+{
+  public:
+    void begin();
+    void setClock(uint32_t clock);
+    void beginTransmission(uint8_t address);
+    void beginTransmission(int address) { beginTransmission((uint8_t)address); }
+    uint8_t endTransmission(uint8_t sendStop = true);
+    uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop = true);
+    uint8_t requestFrom(int address, int quantity) { return requestFrom((uint8_t)address, (uint8_t)quantity); }
+    size_t write(uint8_t data);
+    size_t write(const uint8_t *data, size_t quantity);
+    int available(void);
+    int read(void);
+    int peek(void);
+};
+
+extern TwoWire Wire;
+
+#endif
@@ -0,0 +1,12 @@
+/****************************************
+  Native avr/interrupt.h shim. There are no real interrupts; the HAL
+  runs attached handlers synchronously when an input pin changes.
+*****************************************/
+
+#ifndef _AVR_INTERRUPT_H_
+#define _AVR_INTERRUPT_H_
+
+#define sei() interrupts()
+#define cli() noInterrupts()
+
+#endif
@@ -0,0 +1,49 @@
+/****************************************
+  Native avr/pgmspace.h shim. Flash and RAM share one address space on
+  the host, so PROGMEM is empty and the readers are plain loads.
+
+  pgm_read_word() is also used on AVR to fetch pointers from PROGMEM
+  tables, which works there because pointers are 16 bits. Here it
+  returns the pointer itself when handed the address of one.
+*****************************************/
+
+#ifndef __PGMSPACE_H_
+#define __PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+
+#define PROGMEM __attribute__((section(".progmem.data")))  // kept apart for the ram-report target
+#define PGM_P const char *
+#define PGM_VOID_P const void *
+#define PSTR(s) (s)
+
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+template<class T>
+inline typename std::conditional<std::is_pointer<T>::value, T, uint16_t>::type
+pgm_read_word(const T *addr)
+{
+  return *addr;
+}
+inline uint16_t pgm_read_word(const void *addr)
+{
+  return *(const uint16_t *)addr;
+}
+
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_byte_near(addr) pgm_read_byte(addr)
+#define pgm_read_word_near(addr) pgm_read_word(addr)
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_float(addr) (*(const float *)(addr))
+#define pgm_read_ptr(addr) (*(void * const *)(addr))
+
+#define memcpy_P memcpy
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define strcmp_P strcmp
+#define strlen_P strlen
+
+#endif
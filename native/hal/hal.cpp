@@ -0,0 +1,499 @@
+/****************************************
+  Native HAL: pins, clock, interrupts, random numbers and EEPROM.
+*****************************************/
+
+#include <stdio.h>
+#include <thread>
+
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "hal_state.h"
+
+namespace hal {
+
+State::State()
+{
+  start = std::chrono::steady_clock::now();
+  inHook = false;
+  virt = false;
+  vnow = 0;
+  pollCost = 0;
+  maxStep = 0;
+  endTime = UINT64_MAX;
+  wake = UINT64_MAX;
+  idle = 0;
+  eventSeq = 0;
+  stats = SimStats();
+  for (Pin &p : pins) {
+    p.mode = INPUT;
+    p.out = -1;
+    p.driven = false;
+    p.in = false;
+    p.analog = 0;
+    p.tone = 0;
+  }
+  isr[0] = isr[1] = NULL;
+  isrMode[0] = isrMode[1] = 0;
+  interruptsOn = true;
+  timerIsr = NULL;
+  timerPeriod = 0;
+  timerNext = 0;
+  rng = 1;
+  memset(eeprom, 0xFF, sizeof(eeprom));
+  baud = 0;
+  txDrained = 0;
+  txPending = 0;
+  wireAddr = 0;
+  lcd_reset(lcd);
+}
+
+State &st()
+{
+  thread_local State s;
+  return s;
+}
+
+static bool timer_due(State &s, uint64_t t_us)
+{
+  return s.timerIsr && s.interruptsOn && s.timerNext <= t_us;
+}
+
+// One timer interrupt. The handler may read pins and the clock, but
+// those reads are not polls by the sketch.
+static void run_timer(State &s)
+{
+  if (s.virt && s.timerNext > s.vnow) s.vnow = s.timerNext;
+  s.timerNext += s.timerPeriod;
+  bool was = s.inHook;
+  s.inHook = true;
+  s.timerIsr();
+  s.inHook = was;
+}
+
+// Run every event and timer interrupt due by t_us, in time order,
+// moving the clock to each one in turn
+static void run_events(State &s, uint64_t t_us)
+{
+  for (;;) {
+    bool event = !s.events.empty() && s.events.top().t <= t_us;
+    if (timer_due(s, t_us) && (!event || s.timerNext <= s.events.top().t)) {
+      run_timer(s);
+      continue;
+    }
+    if (!event) return;
+    Event e = s.events.top();
+    s.events.pop();
+    if (e.t > s.vnow) s.vnow = e.t;
+    s.stats.events++;
+    e.fn();
+    s.idle = 0;
+  }
+}
+
+void advance_to(uint64_t t_us)
+{
+  State &s = st();
+  if (t_us > s.endTime) t_us = s.endTime;
+  run_events(s, t_us);
+  if (t_us > s.vnow) s.vnow = t_us;
+  if (s.vnow >= s.endTime) throw SimulationEnd{false};
+}
+
+// The sketch has been polling without anything changing: it is waiting.
+// Move the clock to the first thing that could wake it.
+static void jump(State &s)
+{
+  uint64_t t = s.wake;
+  if (!s.events.empty() && s.events.top().t < t) t = s.events.top().t;
+  if (s.maxStep && (t == UINT64_MAX || t > s.vnow + s.maxStep)) t = s.vnow + s.maxStep;
+  if (t == UINT64_MAX) {
+    if (s.endTime == UINT64_MAX) throw SimulationEnd{true};
+    t = s.endTime;
+  }
+  s.stats.jumps++;
+  s.wake = UINT64_MAX;
+  s.idle = 0;
+  advance_to(t);
+}
+
+// Idle jumps happen when the sketch reads the clock, so time never
+// leaps between a millis() call and the input reads that follow it.
+// A loop that never reads the clock gets its jump on an input read.
+void service(bool clockRead)
+{
+  State &s = st();
+  if (s.virt && !s.inHook) {
+    s.stats.polls++;
+    s.vnow += s.pollCost;
+    if (++s.idle >= SIM_IDLE_POLLS && (clockRead || s.idle >= 4 * SIM_IDLE_POLLS)) jump(s);
+    else advance_to(s.vnow);
+  } else if (!s.virt && !s.inHook && s.timerIsr) {
+    // Real time: catch up on the interrupts since the last poll, but a
+    // stall of more than a few periods loses them, as on the AVR
+    uint64_t now = now_us();
+    if (now > s.timerNext + 8 * s.timerPeriod) s.timerNext = now - now % s.timerPeriod;
+    while (timer_due(s, now)) run_timer(s);
+  }
+  if (s.serviceHook && !s.inHook) {
+    s.inHook = true;
+    s.serviceHook();
+    s.inHook = false;
+  }
+}
+
+void activity()
+{
+  st().idle = 0;
+}
+
+void wake_us(uint64_t t_us)
+{
+  State &s = st();
+  if (t_us > s.vnow && t_us < s.wake) s.wake = t_us;
+}
+
+void set_virtual_time(uint64_t start_us, unsigned poll_cost_us, uint64_t max_step_us)
+{
+  State &s = st();
+  s.virt = true;
+  s.vnow = start_us;
+  s.pollCost = poll_cost_us;
+  s.maxStep = max_step_us;
+  s.txDrained = start_us;
+}
+
+bool virtual_time()
+{
+  return st().virt;
+}
+
+void schedule(uint64_t t_us, std::function<void()> event)
+{
+  State &s = st();
+  s.events.push(Event{t_us, s.eventSeq++, event});
+}
+
+void set_end_time(uint64_t t_us)
+{
+  st().endTime = t_us;
+}
+
+SimStats sim_stats()
+{
+  return st().stats;
+}
+
+void reset()
+{
+  st() = State();
+}
+
+uint64_t now_us()
+{
+  if (st().virt) return st().vnow;
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+    std::chrono::steady_clock::now() - st().start).count();
+}
+
+void set_service_hook(std::function<void()> hook)
+{
+  st().serviceHook = hook;
+}
+
+static bool pin_level(const Pin &p)
+{
+  if (p.mode == OUTPUT) return p.out > 0;
+  if (p.driven) return p.in;
+  return p.mode == INPUT_PULLUP;
+}
+
+void set_input(uint8_t pin, bool level)
+{
+  State &s = st();
+  if (pin >= NUM_DIGITAL_PINS) return;
+  Pin &p = s.pins[pin];
+  bool was = pin_level(p);
+  p.driven = true;
+  p.in = level;
+
+  // External interrupts on pins 2 and 3
+  int irq = digitalPinToInterrupt(pin);
+  if (irq >= 0 && s.isr[irq] && s.interruptsOn && was != level) {
+    int mode = s.isrMode[irq];
+    if (mode == CHANGE || (mode == RISING && level) || (mode == FALLING && !level)) s.isr[irq]();
+  }
+}
+
+void release_input(uint8_t pin)
+{
+  if (pin < NUM_DIGITAL_PINS) st().pins[pin].driven = false;
+}
+
+void set_analog(uint8_t pin, int value)
+{
+  if (pin < NUM_DIGITAL_PINS) st().pins[pin].analog = value;
+}
+
+void set_analog_source(std::function<int(uint8_t, uint64_t)> source)
+{
+  st().analogSource = source;
+}
+
+int output_level(uint8_t pin)
+{
+  return (pin < NUM_DIGITAL_PINS) ? st().pins[pin].out : -1;
+}
+
+unsigned tone_frequency(uint8_t pin)
+{
+  return (pin < NUM_DIGITAL_PINS) ? st().pins[pin].tone : 0;
+}
+
+void on_output(std::function<void(uint8_t, int, uint64_t)> listener)
+{
+  st().outputListener = listener;
+}
+
+void on_tone(std::function<void(uint8_t, unsigned, uint64_t)> listener)
+{
+  st().toneListener = listener;
+}
+
+uint8_t *eeprom()
+{
+  return st().eeprom;
+}
+
+}  // namespace hal
+
+
+// Wake hint from code that polls millis(): it has nothing to do before
+// millis() reaches ms. Works across the 32 bit wrap of millis().
+void hal_wake_at(unsigned long ms)
+{
+  if (!hal::virtual_time()) return;
+  uint64_t now = hal::now_us();
+  int32_t ahead = (int32_t)((uint32_t)ms - (uint32_t)(now / 1000));
+  if (ahead > 0) hal::wake_us(now - now % 1000 + (uint64_t)ahead * 1000);
+}
+
+void hal_timer(unsigned long period_us, void (*isr)(void))
+{
+  hal::State &s = hal::st();
+  if (period_us == 0) isr = NULL;
+  s.timerIsr = isr;
+  s.timerPeriod = period_us;
+  s.timerNext = hal::now_us() + period_us;
+}
+
+using hal::st;
+
+
+//====================
+// Digital and analog I/O
+//====================
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  if (pin >= NUM_DIGITAL_PINS) return;
+  hal::Pin &p = st().pins[pin];
+  p.mode = mode;
+  if (mode == OUTPUT && p.out < 0) p.out = LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+  if (pin >= NUM_DIGITAL_PINS) return;
+  hal::State &s = st();
+  hal::Pin &p = s.pins[pin];
+
+  // As on the AVR, writing HIGH to an input turns on its pullup
+  if (p.mode != OUTPUT) {
+    p.mode = val ? INPUT_PULLUP : INPUT;
+    return;
+  }
+  int level = val ? HIGH : LOW;
+  if (level != p.out) {
+    p.out = level;
+    hal::activity();
+    if (s.outputListener) s.outputListener(pin, level, hal::now_us());
+  }
+}
+
+int digitalRead(uint8_t pin)
+{
+  hal::service();
+  if (pin >= NUM_DIGITAL_PINS) return LOW;
+  return hal::pin_level(st().pins[pin]) ? HIGH : LOW;
+}
+
+int analogRead(uint8_t pin)
+{
+  hal::service();
+  hal::State &s = st();
+  if (pin < A0 && pin < NUM_ANALOG_INPUTS) pin += A0;  // analogRead(0) means A0
+  if (s.analogSource) return s.analogSource(pin, hal::now_us());
+  return (pin < NUM_DIGITAL_PINS) ? s.pins[pin].analog : 0;
+}
+
+void analogWrite(uint8_t pin, int val)
+{
+  pinMode(pin, OUTPUT);
+  digitalWrite(pin, val >= 128 ? HIGH : LOW);
+}
+
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration)
+{
+  (void)duration;
+  if (pin >= NUM_DIGITAL_PINS) return;
+  hal::State &s = st();
+  if (s.pins[pin].tone != frequency) {
+    s.pins[pin].tone = frequency;
+    hal::activity();
+    if (s.toneListener) s.toneListener(pin, frequency, hal::now_us());
+  }
+}
+
+void noTone(uint8_t pin)
+{
+  tone(pin, 0);
+}
+
+
+//====================
+// Time
+//====================
+unsigned long millis(void)
+{
+  hal::service(true);
+  return (uint32_t)(hal::now_us() / 1000);
+}
+
+unsigned long micros(void)
+{
+  hal::service(true);
+  return (uint32_t)hal::now_us();
+}
+
+void delay(unsigned long ms)
+{
+  if (hal::virtual_time()) {
+    hal::service();
+    hal::advance_to(hal::now_us() + (uint64_t)ms * 1000);
+    hal::activity();   // a wait that moved the clock is not idling
+    return;
+  }
+  uint64_t end = hal::now_us() + (uint64_t)ms * 1000;
+  while (hal::now_us() < end) {
+    hal::service();
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  if (hal::virtual_time()) {
+    hal::advance_to(hal::now_us() + us);
+    hal::activity();
+    return;
+  }
+  uint64_t end = hal::now_us() + us;
+  while (hal::now_us() < end);
+}
+
+void yield(void)
+{
+  hal::service(true);
+}
+
+
+//====================
+// Interrupts
+//====================
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode)
+{
+  if (interruptNum > 1) return;
+  st().isr[interruptNum] = userFunc;
+  st().isrMode[interruptNum] = mode;
+}
+
+void detachInterrupt(uint8_t interruptNum)
+{
+  if (interruptNum <= 1) st().isr[interruptNum] = NULL;
+}
+
+void interrupts(void)
+{
+  st().interruptsOn = true;
+}
+
+void noInterrupts(void)
+{
+  st().interruptsOn = false;
+}
+
+
+//====================
+// Random numbers, Park-Miller as in avr-libc so a seed gives the same
+// sequence everywhere.
+//====================
+static long next_random()
+{
+  uint32_t &x = st().rng;
+  long hi, lo, t;
+
+  if (x == 0) x = 123459876;
+  hi = x / 127773;
+  lo = x % 127773;
+  t = 16807 * lo - 2836 * hi;
+  if (t < 0) t += 0x7fffffff;
+  x = t;
+  return t % ((unsigned long)0x7fffffff + 1);
+}
+
+void randomSeed(unsigned long seed)
+{
+  if (seed != 0) st().rng = seed;
+}
+
+long random(long howbig)
+{
+  if (howbig == 0) return 0;
+  return next_random() % howbig;
+}
+
+long random(long howsmall, long howbig)
+{
+  if (howsmall >= howbig) return howsmall;
+  return random(howbig - howsmall) + howsmall;
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max)
+{
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+
+//====================
+// EEPROM
+//====================
+EEPROMClass EEPROM;
+
+uint8_t EEPROMClass::read(int idx)
+{
+  return (idx >= 0 && idx < (int)hal::EEPROM_SIZE) ? st().eeprom[idx] : 0xFF;
+}
+
+void EEPROMClass::write(int idx, uint8_t val)
+{
+  if (idx >= 0 && idx < (int)hal::EEPROM_SIZE) st().eeprom[idx] = val;
+}
+
+void EEPROMClass::update(int idx, uint8_t val)
+{
+  if (read(idx) != val) write(idx, val);
+}
+
+uint16_t EEPROMClass::length()
+{
+  return hal::EEPROM_SIZE;
+}
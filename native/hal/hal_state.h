@@ -0,0 +1,106 @@
+/****************************************
+  Internal state of the native HAL, shared by its translation units.
+*****************************************/
+
+#ifndef hal_state_h
+#define hal_state_h
+
+#include <stdint.h>
+#include <chrono>
+#include <deque>
+#include <queue>
+#include <functional>
+#include <vector>
+
+#include "ArduinoHal.h"
+
+namespace hal {
+
+struct Pin {
+  uint8_t mode;       // INPUT, OUTPUT or INPUT_PULLUP
+  int out;            // last level written, -1 if never
+  bool driven;        // an input level is forced by the harness
+  bool in;            // forced input level
+  int analog;         // analogRead value
+  unsigned tone;      // tone frequency, 0 = silent
+};
+
+struct LcdShield {
+  uint8_t reg[0x16];  // MCP23017 registers, BANK = 0 layout
+  uint8_t ptr;        // register pointer
+  uint8_t buttons;    // BUTTON_* bits held down
+  // HD44780 controller behind port B
+  bool eightBit;
+  bool highNibble;    // next 4 bit transfer is the high half
+  uint8_t nibble;
+  bool lastEnable;
+  bool cgram;         // data writes go to character RAM
+  uint8_t addr;       // DDRAM address
+  bool increment;
+  char ddram[0x80];
+};
+
+struct Event {
+  uint64_t t;
+  uint64_t seq;   // keeps events at the same time in schedule order
+  std::function<void()> fn;
+  bool operator>(const Event &e) const { return t != e.t ? t > e.t : seq > e.seq; }
+};
+
+struct State {
+  State();
+
+  std::chrono::steady_clock::time_point start;
+  std::function<void()> serviceHook;
+  bool inHook;
+
+  // Virtual time
+  bool virt;
+  uint64_t vnow;
+  unsigned pollCost;
+  uint64_t maxStep;
+  uint64_t endTime;
+  uint64_t wake;        // earliest wake hint since the last jump
+  unsigned idle;        // polls since anything changed
+  uint64_t eventSeq;
+  std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+  SimStats stats;
+
+  Pin pins[64];
+  std::function<int(uint8_t, uint64_t)> analogSource;
+  std::function<void(uint8_t, int, uint64_t)> outputListener;
+  std::function<void(uint8_t, unsigned, uint64_t)> toneListener;
+  void (*isr[2])(void);
+  int isrMode[2];
+  bool interruptsOn;
+  void (*timerIsr)(void);
+  uint64_t timerPeriod;
+  uint64_t timerNext;   // HAL time of the next timer interrupt
+
+  uint32_t rng;
+
+  uint8_t eeprom[EEPROM_SIZE];
+
+  unsigned long baud;
+  uint64_t txDrained;   // time the transmit buffer was last accounted
+  unsigned txPending;   // bytes still in the transmit buffer
+  std::deque<uint8_t> rx;
+  std::function<void(const uint8_t *, size_t)> serialSink;
+
+  uint8_t wireAddr;
+  std::vector<uint8_t> wireTx;
+  std::deque<uint8_t> wireRx;
+  LcdShield lcd;
+  std::function<void()> lcdListener;
+};
+
+State &st();
+void service(bool clockRead = false);  // a poll: run due events and the service hook, move virtual time
+void activity();       // something changed, the sketch is not idle
+void wake_us(uint64_t t_us);  // wake hint in HAL time
+void advance_to(uint64_t t_us);  // move virtual time forward, running due events
+void lcd_reset(LcdShield &lcd);
+
+}  // namespace hal
+
+#endif
@@ -0,0 +1,131 @@
+/****************************************
+  Native HardwareSerial.
+*****************************************/
+
+#include <stdio.h>
+
+#include "Arduino.h"
+#include "hal_state.h"
+
+HardwareSerial Serial;
+
+namespace hal {
+
+void serial_input(const char *data, size_t len)
+{
+  State &s = st();
+  for (size_t i = 0; i < len; i++) s.rx.push_back((uint8_t)data[i]);
+  activity();
+}
+
+void set_serial_sink(std::function<void(const uint8_t *, size_t)> sink)
+{
+  st().serialSink = sink;
+}
+
+unsigned long serial_baud()
+{
+  return st().baud;
+}
+
+// Account for the bytes the UART has shifted out since the last look.
+// Ten bits per byte: start, 8 data, stop.
+static void tx_drain(State &s)
+{
+  uint64_t now = now_us();
+  if (s.baud == 0) {
+    s.txPending = 0;
+    s.txDrained = now;
+    return;
+  }
+  uint64_t sent = (now - s.txDrained) * s.baud / 10000000;
+  if (sent >= s.txPending) {
+    s.txPending = 0;
+    s.txDrained = now;
+  } else if (sent > 0) {
+    s.txPending -= sent;
+    s.txDrained += sent * 10000000 / s.baud;
+  }
+}
+
+}  // namespace hal
+
+using hal::st;
+
+void HardwareSerial::begin(unsigned long baud)
+{
+  hal::State &s = st();
+  s.baud = baud;
+  s.txPending = 0;
+  s.txDrained = hal::now_us();
+}
+
+void HardwareSerial::end()
+{
+  flush();
+  st().baud = 0;
+}
+
+int HardwareSerial::available(void)
+{
+  hal::service();
+  return st().rx.size();
+}
+
+int HardwareSerial::peek(void)
+{
+  hal::State &s = st();
+  return s.rx.empty() ? -1 : s.rx.front();
+}
+
+int HardwareSerial::read(void)
+{
+  hal::State &s = st();
+  if (s.rx.empty()) return -1;
+  int c = s.rx.front();
+  s.rx.pop_front();
+  hal::activity();  // a sketch reading input a slice at a time is not idle
+  return c;
+}
+
+int HardwareSerial::availableForWrite(void)
+{
+  hal::State &s = st();
+  hal::tx_drain(s);
+  return SERIAL_TX_BUFFER_SIZE - 1 - s.txPending;
+}
+
+void HardwareSerial::flush(void)
+{
+  hal::State &s = st();
+  while (s.txPending) {
+    hal::tx_drain(s);
+    if (s.txPending) hal::wake_us(s.txDrained + 10000000 / s.baud);
+    yield();
+  }
+}
+
+// Blocks while the transmit buffer is full, like the AVR core
+size_t HardwareSerial::write(uint8_t c)
+{
+  hal::State &s = st();
+
+  if (s.baud) {
+    hal::tx_drain(s);
+    while (s.txPending >= SERIAL_TX_BUFFER_SIZE - 1) {
+      hal::wake_us(s.txDrained + 10000000 / s.baud);  // next byte out
+      yield();
+      hal::tx_drain(s);
+    }
+    s.txPending++;
+  }
+
+  hal::activity();
+  if (s.serialSink) {
+    s.serialSink(&c, 1);
+  } else {
+    fputc(c, stdout);
+    if (c == '\n') fflush(stdout);
+  }
+  return 1;
+}
@@ -0,0 +1,239 @@
+/****************************************
+  Native TwoWire and a model of the Adafruit RGB LCD shield: an
+  MCP23017 port expander at 0x20 with five buttons on port A, the
+  backlight on A6, A7 and B0, and an HD44780 in 4 bit mode on port B.
+*****************************************/
+
+#include "Arduino.h"
+#include "Wire.h"
+#include "hal_state.h"
+
+TwoWire Wire;
+
+namespace hal {
+
+const uint8_t LCD_ADDR = 0x20;
+const uint8_t IODIRA = 0x00;
+const uint8_t GPPUA = 0x0C;
+const uint8_t GPIOA = 0x12;
+const uint8_t GPIOB = 0x13;
+const uint8_t OLATA = 0x14;
+const uint8_t OLATB = 0x15;
+
+// Port B wiring of the HD44780
+const uint8_t LCD_RS = 0x80;
+const uint8_t LCD_E = 0x20;
+
+void lcd_reset(LcdShield &lcd)
+{
+  memset(lcd.reg, 0, sizeof(lcd.reg));
+  lcd.reg[IODIRA] = 0xFF;
+  lcd.reg[IODIRA + 1] = 0xFF;
+  lcd.ptr = 0;
+  lcd.buttons = 0;
+  lcd.eightBit = true;
+  lcd.highNibble = true;
+  lcd.nibble = 0;
+  lcd.lastEnable = false;
+  lcd.cgram = false;
+  lcd.addr = 0;
+  lcd.increment = true;
+  memset(lcd.ddram, ' ', sizeof(lcd.ddram));
+}
+
+static void lcd_changed()
+{
+  activity();
+  if (st().lcdListener) st().lcdListener();
+}
+
+static void hd44780_command(LcdShield &lcd, uint8_t cmd)
+{
+  if (cmd & 0x80) {         // set DDRAM address
+    lcd.addr = cmd & 0x7F;
+    lcd.cgram = false;
+  } else if (cmd & 0x40) {  // set CGRAM address
+    lcd.cgram = true;
+  } else if (cmd & 0x20) {  // function set
+    lcd.eightBit = cmd & 0x10;
+    lcd.highNibble = true;
+  } else if (cmd & 0x10) {  // cursor or display shift, display contents unchanged
+  } else if (cmd & 0x08) {  // display control
+  } else if (cmd & 0x04) {  // entry mode
+    lcd.increment = cmd & 0x02;
+  } else if (cmd & 0x02) {  // home
+    lcd.addr = 0;
+  } else if (cmd & 0x01) {  // clear
+    memset(lcd.ddram, ' ', sizeof(lcd.ddram));
+    lcd.addr = 0;
+    lcd.increment = true;
+    lcd_changed();
+  }
+}
+
+static void hd44780_data(LcdShield &lcd, uint8_t c)
+{
+  if (lcd.cgram) return;
+  lcd.ddram[lcd.addr & 0x7F] = c;
+  lcd.addr = (lcd.addr + (lcd.increment ? 1 : -1)) & 0x7F;
+  lcd_changed();
+}
+
+// Port B was written. The HD44780 latches on the falling edge of E.
+static void lcd_port_b(LcdShield &lcd, uint8_t b)
+{
+  bool enable = b & LCD_E;
+  if (lcd.lastEnable && !enable) {
+    // Data pins 12, 11, 10, 9 carry bits 0..3 of the nibble
+    uint8_t n = ((b >> 4) & 1) | (((b >> 3) & 1) << 1) | (((b >> 2) & 1) << 2) | (((b >> 1) & 1) << 3);
+    bool rs = b & LCD_RS;
+    if (lcd.eightBit) {
+      // Only the upper four data lines are wired, the lower read as 0
+      if (rs) hd44780_data(lcd, n << 4);
+      else hd44780_command(lcd, n << 4);
+    } else if (lcd.highNibble) {
+      lcd.nibble = n;
+      lcd.highNibble = false;
+    } else {
+      uint8_t v = (lcd.nibble << 4) | n;
+      lcd.highNibble = true;
+      if (rs) hd44780_data(lcd, v);
+      else hd44780_command(lcd, v);
+    }
+  }
+  lcd.lastEnable = enable;
+}
+
+static uint8_t mcp_read(LcdShield &lcd, uint8_t r)
+{
+  if (r == GPIOA || r == GPIOB) {
+    uint8_t iodir = lcd.reg[r - GPIOA];
+    uint8_t in = 0xFF;  // undriven inputs float high on the shield
+    if (r == GPIOA) in &= ~(lcd.buttons & 0x1F);
+    return (in & iodir) | (lcd.reg[r + 2] & ~iodir);
+  }
+  return (r < sizeof(lcd.reg)) ? lcd.reg[r] : 0;
+}
+
+static void mcp_write(LcdShield &lcd, uint8_t r, uint8_t v)
+{
+  if (r == GPIOA || r == GPIOB) r += 2;  // writes to GPIO land in the latch
+  if (r >= sizeof(lcd.reg)) return;
+  uint8_t old = lcd.reg[r];
+  lcd.reg[r] = v;
+  if (r == OLATB) lcd_port_b(lcd, v);
+  if ((r == OLATA && ((old ^ v) & 0xC0)) || (r == OLATB && ((old ^ v) & 0x01))) lcd_changed();
+}
+
+void press_buttons(uint8_t mask)
+{
+  st().lcd.buttons = mask;
+  activity();
+}
+
+std::string lcd_line(int row)
+{
+  const LcdShield &lcd = st().lcd;
+  return std::string(lcd.ddram + (row ? 0x40 : 0x00), 16);
+}
+
+// The backlight LEDs are active low: red on A6, green on A7, blue on B0
+uint8_t lcd_backlight()
+{
+  const LcdShield &lcd = st().lcd;
+  uint8_t a = lcd.reg[OLATA];
+  uint8_t b = lcd.reg[OLATB];
+  return (((a >> 6) & 1) ? 0 : 0x1) | (((a >> 7) & 1) ? 0 : 0x2) | ((b & 1) ? 0 : 0x4);
+}
+
+void on_lcd_change(std::function<void()> listener)
+{
+  st().lcdListener = listener;
+}
+
+}  // namespace hal
+
+using hal::st;
+
+void TwoWire::begin()
+{
+}
+
+void TwoWire::setClock(uint32_t clock)
+{
+  (void)clock;
+}
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+  st().wireAddr = address;
+  st().wireTx.clear();
+}
+
+size_t TwoWire::write(uint8_t data)
+{
+  st().wireTx.push_back(data);
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity)
+{
+  for (size_t i = 0; i < quantity; i++) write(data[i]);
+  return quantity;
+}
+
+// 0 = success, 2 = address not acknowledged
+uint8_t TwoWire::endTransmission(uint8_t sendStop)
+{
+  (void)sendStop;
+  hal::State &s = st();
+  if (s.wireAddr != hal::LCD_ADDR) return 2;
+
+  hal::LcdShield &lcd = s.lcd;
+  for (size_t i = 0; i < s.wireTx.size(); i++) {
+    if (i == 0) {
+      lcd.ptr = s.wireTx[0];
+    } else {
+      hal::mcp_write(lcd, lcd.ptr, s.wireTx[i]);
+      lcd.ptr = (lcd.ptr + 1) % sizeof(lcd.reg);
+    }
+  }
+  s.wireTx.clear();
+  return 0;
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop)
+{
+  (void)sendStop;
+  hal::service();
+  hal::State &s = st();
+  s.wireRx.clear();
+  if (address != hal::LCD_ADDR) return 0;
+
+  hal::LcdShield &lcd = s.lcd;
+  for (uint8_t i = 0; i < quantity; i++) {
+    s.wireRx.push_back(hal::mcp_read(lcd, lcd.ptr));
+    lcd.ptr = (lcd.ptr + 1) % sizeof(lcd.reg);
+  }
+  return quantity;
+}
+
+int TwoWire::available(void)
+{
+  return st().wireRx.size();
+}
+
+int TwoWire::read(void)
+{
+  hal::State &s = st();
+  if (s.wireRx.empty()) return -1;
+  int v = s.wireRx.front();
+  s.wireRx.pop_front();
+  return v;
+}
+
+int TwoWire::peek(void)
+{
+  hal::State &s = st();
+  return s.wireRx.empty() ? -1 : s.wireRx.front();
+}
@@ -0,0 +1,142 @@
+/****************************************
+  Native runner for the CW Trainer sketch.
+
+  Runs setup() and loop() in real time against the HAL. The sketch's
+  serial telemetry is decoded to a log on stdout. Keys on stdin work the LCD shield buttons:
+    w = up, s = down, a = left, d = right, space or enter = select
+  Options:
+    --lcd          echo the LCD to stderr whenever it changes
+    --eeprom FILE  load EEPROM contents from FILE and save changes back
+    --raw          write the binary telemetry to stdout instead of a log
+*****************************************/
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "ArduinoHal.h"
+#include "tele_parser.h"
+#include <Adafruit_RGBLCDShield.h>
+
+static const char *eeprom_file = NULL;
+static std::vector<uint8_t> eeprom_saved;
+static uint64_t release_at = 0;
+static uint64_t next_poll = 0;
+static struct termios saved_tty;
+static bool raw_tty = false;
+
+static void restore_tty()
+{
+  if (raw_tty) tcsetattr(0, TCSANOW, &saved_tty);
+}
+
+static void load_eeprom()
+{
+  FILE *f = fopen(eeprom_file, "rb");
+  if (f) {
+    size_t n = fread(hal::eeprom(), 1, hal::EEPROM_SIZE, f);
+    (void)n;
+    fclose(f);
+  }
+  eeprom_saved.assign(hal::eeprom(), hal::eeprom() + hal::EEPROM_SIZE);
+}
+
+static void save_eeprom()
+{
+  if (memcmp(eeprom_saved.data(), hal::eeprom(), hal::EEPROM_SIZE) == 0) return;
+  FILE *f = fopen(eeprom_file, "wb");
+  if (!f) return;
+  fwrite(hal::eeprom(), 1, hal::EEPROM_SIZE, f);
+  fclose(f);
+  eeprom_saved.assign(hal::eeprom(), hal::eeprom() + hal::EEPROM_SIZE);
+}
+
+// Every 10 ms: turn keystrokes into button presses held for 150 ms
+// and keep the EEPROM file up to date.
+static void poll()
+{
+  uint64_t now = hal::now_us();
+  if (now < next_poll) return;
+  next_poll = now + 10000;
+
+  if (release_at && now >= release_at) {
+    hal::press_buttons(0);
+    release_at = 0;
+  }
+
+  char c;
+  while (read(0, &c, 1) == 1) {
+    uint8_t b = 0;
+    switch (c) {
+      case 'w': b = BUTTON_UP; break;
+      case 's': b = BUTTON_DOWN; break;
+      case 'a': b = BUTTON_LEFT; break;
+      case 'd': b = BUTTON_RIGHT; break;
+      case ' ':
+      case '\n': b = BUTTON_SELECT; break;
+    }
+    if (b) {
+      hal::press_buttons(b);
+      release_at = now + 150000;
+    }
+  }
+
+  if (eeprom_file) save_eeprom();
+}
+
+int main(int argc, char **argv)
+{
+  bool echo_lcd = false;
+  bool raw = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--lcd")) {
+      echo_lcd = true;
+    } else if (!strcmp(argv[i], "--eeprom") && i + 1 < argc) {
+      eeprom_file = argv[++i];
+    } else if (!strcmp(argv[i], "--raw")) {
+      raw = true;
+    } else {
+      fprintf(stderr, "Usage: %s [--lcd] [--eeprom FILE] [--raw]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  if (eeprom_file) load_eeprom();
+  TeleParser telemetry([](const TeleEvent &ev) {
+    printf("%s\n", tele_log(ev).c_str());
+    fflush(stdout);
+  });
+  hal::set_serial_sink([&](const uint8_t *data, size_t len) {
+    if (raw) {
+      fwrite(data, 1, len, stdout);
+      fflush(stdout);
+    } else {
+      telemetry.feed(data, len);
+    }
+  });
+  if (echo_lcd) {
+    hal::on_lcd_change([]() {
+      fprintf(stderr, "\r[%s|%s]", hal::lcd_line(0).c_str(), hal::lcd_line(1).c_str());
+    });
+  }
+
+  if (isatty(0) && tcgetattr(0, &saved_tty) == 0) {
+    struct termios raw = saved_tty;
+    raw.c_lflag &= ~(ICANON | ECHO);
+    tcsetattr(0, TCSANOW, &raw);
+    raw_tty = true;
+    atexit(restore_tty);
+  }
+  fcntl(0, F_SETFL, fcntl(0, F_GETFL) | O_NONBLOCK);
+  hal::set_service_hook(poll);
+
+  setup();
+  for (;;) loop();
+}
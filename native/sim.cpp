@@ -0,0 +1,237 @@
+/****************************************
+  Virtual time runner for the CW Trainer sketch.
+
+  Runs setup() and loop() against the HAL's virtual clock, so a long
+  session finishes as fast as the sketch can compute it and the same
+  seed and script always give the same run. The sketch's serial
+  telemetry is decoded to a log on stdout, a summary goes to stderr.
+
+  Options:
+    --seed N        start the clock N microseconds in; the sketch seeds
+                    random() from micros() so this picks the run (default 1)
+    --duration S    virtual seconds to run (default 7200)
+    --start-ms MS   start the clock at MS milliseconds, e.g. 4294960000
+                    to run through the millis() wrap
+    --script FILE   timed inputs, see below
+    --lcd           print the LCD to stderr whenever it changes
+    --quiet         drop serial output
+    --raw           write the binary telemetry to stdout instead of a log
+    --trainee       answer the trainer with a simulated student:
+      --error-rate P    chance of a copying error per character (0.05)
+      --react MS        reaction time (400)
+      --speed-offset W  reply speed relative to the sender, wpm (0)
+      --jitter F        element timing error as a fraction (0.1)
+      --paddle A|B      reply on iambic paddles, with the trainer's
+                        keyer set to that mode
+      --check           fail unless the trainer scored exactly what the
+                        trainee keyed, at least a round every 5 s
+
+  Script lines are "<ms> <action> [arg]", times relative to the start:
+    <ms> tap up|down|left|right|select   press a button for 150 ms
+    <ms> press <button>|none             hold buttons down, or release
+    <ms> key down|up                     morse key input (pin 2)
+    <ms> paddle dot|dash|both|none       hold paddles (pins 2 and 3)
+    <ms> serial <text>                   bytes to the serial port
+  '#' starts a comment. Without a script the sketch is sent straight
+  into the trainer from the main menu.
+*****************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+
+#include "Arduino.h"
+#include "ArduinoHal.h"
+#include "tele_parser.h"
+#include "trainee.h"
+#include <Adafruit_RGBLCDShield.h>
+
+static const uint8_t key_in_pin = 2;   // morseInPin in the sketch, active low
+static const uint8_t dash_in_pin = 3;  // dashInPin, the dash paddle
+static uint64_t start_us;
+
+static uint8_t button_mask(const char *name)
+{
+  if (!strcmp(name, "up")) return BUTTON_UP;
+  if (!strcmp(name, "down")) return BUTTON_DOWN;
+  if (!strcmp(name, "left")) return BUTTON_LEFT;
+  if (!strcmp(name, "right")) return BUTTON_RIGHT;
+  if (!strcmp(name, "select")) return BUTTON_SELECT;
+  return 0;
+}
+
+// Schedule one script line, false if it makes no sense
+static bool script_line(char *line)
+{
+  char *hash = strchr(line, '#');
+  if (hash) *hash = '\0';
+
+  char action[16], arg[256];
+  double ms;
+  int n = sscanf(line, "%lf %15s %255[^\n]", &ms, action, arg);
+  if (n <= 0) return true;  // blank line
+  if (n < 3) return false;
+  uint64_t t = start_us + (uint64_t)(ms * 1000);
+
+  if (!strcmp(action, "tap") && button_mask(arg)) {
+    uint8_t b = button_mask(arg);
+    hal::schedule(t, [b]() { hal::press_buttons(b); });
+    hal::schedule(t + 150000, []() { hal::press_buttons(0); });
+  } else if (!strcmp(action, "press")) {
+    uint8_t b = button_mask(arg);
+    if (!b && strcmp(arg, "none")) return false;
+    hal::schedule(t, [b]() { hal::press_buttons(b); });
+  } else if (!strcmp(action, "key")) {
+    if (strcmp(arg, "down") && strcmp(arg, "up")) return false;
+    bool level = strcmp(arg, "down") != 0;  // active low
+    hal::schedule(t, [level]() { hal::set_input(key_in_pin, level); });
+  } else if (!strcmp(action, "paddle")) {
+    bool dot = !strcmp(arg, "dot") || !strcmp(arg, "both");
+    bool dash = !strcmp(arg, "dash") || !strcmp(arg, "both");
+    if (!dot && !dash && strcmp(arg, "none")) return false;
+    hal::schedule(t, [dot, dash]() {
+      hal::set_input(key_in_pin, !dot);   // active low
+      hal::set_input(dash_in_pin, !dash);
+    });
+  } else if (!strcmp(action, "serial")) {
+    std::string text = std::string(arg) + "\n";
+    hal::schedule(t, [text]() { hal::serial_input(text.data(), text.size()); });
+  } else {
+    return false;
+  }
+  return true;
+}
+
+static bool load_script(const char *file)
+{
+  FILE *f = fopen(file, "r");
+  if (!f) {
+    perror(file);
+    return false;
+  }
+  char line[300];
+  int n = 0;
+  bool ok = true;
+  while (fgets(line, sizeof(line), f)) {
+    n++;
+    if (!script_line(line)) {
+      fprintf(stderr, "%s:%d: bad script line\n", file, n);
+      ok = false;
+    }
+  }
+  fclose(f);
+  return ok;
+}
+
+int main(int argc, char **argv)
+{
+  unsigned long seed = 1;
+  double duration = 7200;
+  uint64_t start_ms = 0;
+  const char *script = NULL;
+  bool echo_lcd = false;
+  bool quiet = false;
+  bool raw = false;
+  bool with_trainee = false;
+  bool check = false;
+  TraineeConfig tc;
+  const char *paddle_mode = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--seed") && i + 1 < argc) {
+      seed = strtoul(argv[++i], NULL, 0);
+    } else if (!strcmp(argv[i], "--duration") && i + 1 < argc) {
+      duration = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--start-ms") && i + 1 < argc) {
+      start_ms = strtoull(argv[++i], NULL, 0);
+    } else if (!strcmp(argv[i], "--script") && i + 1 < argc) {
+      script = argv[++i];
+    } else if (!strcmp(argv[i], "--lcd")) {
+      echo_lcd = true;
+    } else if (!strcmp(argv[i], "--quiet")) {
+      quiet = true;
+    } else if (!strcmp(argv[i], "--raw")) {
+      raw = true;
+    } else if (!strcmp(argv[i], "--trainee")) {
+      with_trainee = true;
+    } else if (!strcmp(argv[i], "--check")) {
+      check = true;
+    } else if (!strcmp(argv[i], "--error-rate") && i + 1 < argc) {
+      tc.errorRate = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--react") && i + 1 < argc) {
+      tc.reactMs = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--speed-offset") && i + 1 < argc) {
+      tc.speedOffset = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--jitter") && i + 1 < argc) {
+      tc.jitter = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--paddle") && i + 1 < argc &&
+               (!strcmp(argv[i+1], "A") || !strcmp(argv[i+1], "B"))) {
+      tc.paddles = true;
+      paddle_mode = argv[++i];
+    } else {
+      fprintf(stderr, "Usage: %s [--seed N] [--duration S] [--start-ms MS] [--script FILE] [--lcd] [--quiet] [--raw]\n"
+                      "       [--trainee [--error-rate P] [--react MS] [--speed-offset W] [--jitter F] [--paddle A|B] [--check]]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  start_us = start_ms * 1000 + seed;
+  hal::set_virtual_time(start_us);
+  hal::set_end_time(start_us + (uint64_t)(duration * 1e6));
+
+  if (script) {
+    if (!load_script(script)) return 1;
+  } else {
+    char enter_trainer[] = "1000 tap select";
+    script_line(enter_trainer);
+  }
+  if (paddle_mode) {
+    char set_keyer[32];
+    snprintf(set_keyer, sizeof(set_keyer), "500 serial set in %d", *paddle_mode == 'A' ? 1 : 2);
+    script_line(set_keyer);
+  }
+
+  tc.seed = seed;
+  Trainee trainee(tc);
+  if (with_trainee) trainee.attach();
+  TeleParser telemetry([&](const TeleEvent &ev) {
+    if (with_trainee) trainee.event(ev);
+    if (!quiet && !raw) puts(tele_log(ev).c_str());
+  });
+  hal::set_serial_sink([&](const uint8_t *data, size_t len) {
+    telemetry.feed(data, len);
+    if (!quiet && raw) fwrite(data, 1, len, stdout);
+  });
+  if (echo_lcd) {
+    hal::on_lcd_change([]() {
+      fprintf(stderr, "%10.3f [%s|%s]\n", (hal::now_us() - start_us) / 1e6,
+              hal::lcd_line(0).c_str(), hal::lcd_line(1).c_str());
+    });
+  }
+
+  auto wall = std::chrono::steady_clock::now();
+  bool idle = false;
+  try {
+    setup();
+    for (;;) loop();
+  } catch (const hal::SimulationEnd &end) {
+    idle = end.idle;
+  }
+  fflush(stdout);
+  double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall).count();
+
+  hal::SimStats stats = hal::sim_stats();
+  fprintf(stderr, "%s after %.3f s virtual, %.3f s wall\n",
+          idle ? "Stopped idle" : "Finished", (hal::now_us() - start_us) / 1e6, wall_s);
+  fprintf(stderr, "%llu polls, %llu clock jumps, %llu events\n",
+          (unsigned long long)stats.polls, (unsigned long long)stats.jumps,
+          (unsigned long long)stats.events);
+  fprintf(stderr, "%lu telemetry frames, %lu events dropped, %lu bad bytes\n",
+          telemetry.frames(), telemetry.dropped(), telemetry.badBytes());
+  if (with_trainee) trainee.print(stderr);
+  if (check && !(with_trainee && trainee.check(stderr, (hal::now_us() - start_us) / 1e6))) return 1;
+  return 0;
+}
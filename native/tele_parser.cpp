@@ -0,0 +1,320 @@
+/****************************************
+  Host side decoder for the sketch's binary telemetry.
+  See tele_parser.h for a description.
+*****************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "tele_parser.h"
+
+TeleParser::TeleParser(std::function<void(const TeleEvent &)> onEvent)
+  : onEvent(onEvent), lastMs(0), wraps(0), nFrames(0), nBad(0), nDropped(0)
+{
+}
+
+void TeleParser::feed(const uint8_t *data, size_t len)
+{
+  buf.insert(buf.end(), data, data + len);
+
+  size_t at = 0;
+  while (at < buf.size()) {
+    if (buf[at] != TEL_SYNC) {
+      at++;
+      nBad++;
+      continue;
+    }
+    if (buf.size() - at < TEL_HEADER) break;
+    size_t flen = TEL_OVERHEAD + buf[at + 2];
+    if (buf.size() - at < flen) break;
+
+    uint8_t check = 0;
+    for (size_t i = 1; i < flen; i++) check ^= buf[at + i];
+    if (check) {  // includes the check byte, so a good frame gives 0
+      at++;
+      nBad++;
+      continue;
+    }
+
+    TeleEvent ev;
+    uint32_t ms = buf[at + 3] | buf[at + 4] << 8 | buf[at + 5] << 16 | (uint32_t)buf[at + 6] << 24;
+    if (ms < lastMs && lastMs - ms > 0x80000000u) wraps++;
+    lastMs = ms;
+    ev.id = buf[at + 1];
+    ev.ms = wraps << 32 | ms;
+    ev.len = buf[at + 2];
+    ev.data = &buf[at + TEL_HEADER];
+    nFrames++;
+    if (ev.id == TEL_DROPPED) nDropped += ev.u16(0);
+    onEvent(ev);
+    at += flen;
+  }
+  buf.erase(buf.begin(), buf.begin() + at);
+}
+
+
+static const char *const event_names[NUM_TEL_EVENTS] = {
+  "?", "boot", "dropped", "mode", "pref", "send", "tx", "check", "rx", "score", "timing", "profile",
+  "reply", "prefs", "stats", "mem"
+};
+
+// Main menu entries, TEL_MODE
+static const char *const mode_names[] = {"menu", "trainer", "decoder", "prefs", "paris", "qso"};
+
+// Preference indexes in the sketch, TEL_PREF
+static const char *const pref_names[] = {
+  "saved flag", "group size", "char delay", "key speed", "char set", "koch number", "koch skip", "out mode",
+  "in mode", "early copy"
+};
+
+// Short names, as the sketch's serial commands take them, TEL_PREFS
+static const char *const pref_words[] = {
+  "saved", "group", "delay", "speed", "charset", "koch", "skip", "out", "in", "early"
+};
+
+// TEL_REPLY status
+static const char *const status_names[] = {"ok", "unknown", "bad argument", "too long"};
+
+// Profiler slots in cw-trainer/Profile.h, TEL_PROFILE
+static const char *const slot_names[] = {
+  "decode", "encode", "lcd", "buttons", "serial", "check loop", "decode loop", "send loop"
+};
+
+#define NAME(table, i) ((i) < sizeof(table) / sizeof(table[0]) ? table[i] : "?")
+
+const char *tele_name(uint8_t id)
+{
+  return id < NUM_TEL_EVENTS ? event_names[id] : "?";
+}
+
+// Event text, or its first len bytes, with the prosign codes of
+// MorseCode.h (MORSE_AR '\x01' to MORSE_SOS '\x05') spelled out
+static std::string text(const TeleEvent &ev, size_t len = 255)
+{
+  static const char *const prosigns[] = {"<AR>", "<BT>", "<KN>", "<SK>", "<SOS>"};
+  std::string s;
+  for (size_t i = 0; i < ev.len && i < len; i++) {
+    unsigned char c = ev.data[i];
+    if (c >= 1 && c <= 5) s += prosigns[c - 1];
+    else s += (char)c;
+  }
+  return s;
+}
+
+// The command word after a TEL_REPLY status
+static std::string reply_word(const TeleEvent &ev)
+{
+  return ev.len ? std::string((const char *)ev.data + 1, ev.len - 1) : std::string();
+}
+
+static std::string all_prefs(const TeleEvent &ev)
+{
+  std::string s;
+  char buf[24];
+  for (size_t i = 0; i < ev.len; i++) {
+    snprintf(buf, sizeof(buf), "%s%s=%u", i ? " " : "", NAME(pref_words, i), ev.data[i]);
+    s += buf;
+  }
+  return s;
+}
+
+static std::string binary(unsigned v)
+{
+  std::string s;
+  do {
+    s.insert(s.begin(), (v & 1) ? '1' : '0');
+    v >>= 1;
+  } while (v);
+  return s;
+}
+
+std::string tele_log(const TeleEvent &ev)
+{
+  char line[160];
+  int n = snprintf(line, sizeof(line), "%10.3f %-8s ", ev.ms / 1000.0, tele_name(ev.id));
+  char *p = line + n;
+  size_t room = sizeof(line) - n;
+
+  switch (ev.id) {
+    case TEL_BOOT:
+    case TEL_CHECK:
+      snprintf(line, sizeof(line), "%10.3f %s", ev.ms / 1000.0, tele_name(ev.id));
+      break;
+    case TEL_DROPPED:
+      snprintf(p, room, "%u events lost", ev.u16(0));
+      break;
+    case TEL_MODE:
+      snprintf(p, room, "%s", NAME(mode_names, ev.u8(0)));
+      break;
+    case TEL_PREF:
+      snprintf(p, room, "%s = %u", NAME(pref_names, ev.u8(0)), ev.u8(1));
+      break;
+    case TEL_SEND:
+    case TEL_TX:
+      snprintf(p, room, "%s", text(ev).c_str());
+      break;
+    case TEL_RX:
+      if (ev.len < 3) snprintf(p, room, "%s", text(ev).c_str());
+      else if (!ev.u8(2)) snprintf(p, room, "%s  %u%%", text(ev, 1).c_str(), ev.u8(1));
+      else snprintf(p, room, "%s  %u%%, or %c", text(ev, 1).c_str(), ev.u8(1), ev.u8(2));
+      break;
+    case TEL_SCORE:
+      n = snprintf(p, room, "S/I/D = %u/%u/%u miss = %s",
+                   ev.u8(0), ev.u8(1), ev.u8(2), binary(ev.u16(3)).c_str());
+      if (ev.u8(5) && (size_t)n < room) snprintf(p + n, room - n, ", %u borderline", ev.u8(5));
+      break;
+    case TEL_TIMING:
+      snprintf(p, room, "react %u ms, gap avg %u max %u ms, %u wpm",
+               ev.u16(0), ev.u16(2), ev.u16(4), ev.u8(6));
+      break;
+    case TEL_PROFILE: {
+      unsigned long count = ev.u32(1), total = ev.u32(5);
+      snprintf(p, room, "%-11s count %lu total %lu avg %lu max %lu us", NAME(slot_names, ev.u8(0)),
+               count, total, count ? total / count : 0, ev.u32(9));
+      break;
+    }
+    case TEL_REPLY: {
+      std::string w = reply_word(ev);
+      snprintf(p, room, "%s%s%s", NAME(status_names, ev.u8(0)), w.empty() ? "" : " ", w.c_str());
+      break;
+    }
+    case TEL_PREFS:
+      snprintf(p, room, "%s", all_prefs(ev).c_str());
+      break;
+    case TEL_STATS:
+      snprintf(p, room, "%s, %u rounds, %u perfect, %u chars, S/I/D = %u/%u/%u",
+               NAME(mode_names, ev.u8(0)), ev.u16(1), ev.u16(3), ev.u16(5), ev.u16(7), ev.u16(9), ev.u16(11));
+      break;
+    case TEL_MEM:
+      if (ev.u8(0)) {
+        snprintf(p, room, "static %u heap %u free %u stack max %u never used %u bytes",
+                 ev.u16(1), ev.u16(3), ev.u16(5), ev.u16(7), ev.u16(9));
+      } else {
+        snprintf(p, room, "not measured on this build");
+      }
+      break;
+    default:
+      for (size_t i = 0; i < ev.len && room > 3; i++, p += 3, room -= 3) snprintf(p, room, "%02x ", ev.data[i]);
+      *p = '\0';
+      break;
+  }
+  return line;
+}
+
+const char *tele_csv_header()
+{
+  return "ms,event,a,b,c,d,text";
+}
+
+// Columns a-d and text by event:
+//   dropped  a = count
+//   mode     a = menu entry, text = name
+//   pref     a = index, b = value, text = name
+//   send, tx text = characters
+//   rx       a = confidence, b = next best reading (ASCII, 0 none),
+//            text = character
+//   score    a/b/c = subs/inserts/deletes, d = miss mask,
+//            text = borderline subs
+//   timing   a = reaction ms, b = gap avg ms, c = gap max ms, d = wpm
+//   profile  a = count, b = total us, c = max us, text = slot
+//   reply    a = status, text = command word
+//   prefs    text = "name=value" for every preference
+//   stats    a = rounds, b = perfect, c = characters, d = mode,
+//            text = "subs/inserts/deletes"
+//   mem      a = free, b = stack max, c = never used, d = static,
+//            text = "measured" or empty
+std::string tele_csv(const TeleEvent &ev)
+{
+  unsigned long f[4] = {0, 0, 0, 0};
+  int nf = 0;
+  std::string t;
+
+  switch (ev.id) {
+    case TEL_DROPPED:
+      f[0] = ev.u16(0);
+      nf = 1;
+      break;
+    case TEL_MODE:
+      f[0] = ev.u8(0);
+      nf = 1;
+      t = NAME(mode_names, ev.u8(0));
+      break;
+    case TEL_PREF:
+      f[0] = ev.u8(0);
+      f[1] = ev.u8(1);
+      nf = 2;
+      t = NAME(pref_names, ev.u8(0));
+      break;
+    case TEL_SEND:
+    case TEL_TX:
+      t = text(ev);
+      break;
+    case TEL_RX:
+      if (ev.len >= 3) {
+        f[0] = ev.u8(1);
+        f[1] = ev.u8(2);
+        nf = 2;
+      }
+      t = text(ev, 1);
+      break;
+    case TEL_SCORE:
+      f[0] = ev.u8(0);
+      f[1] = ev.u8(1);
+      f[2] = ev.u8(2);
+      f[3] = ev.u16(3);
+      nf = 4;
+      t = std::to_string(ev.u8(5));
+      break;
+    case TEL_TIMING:
+      f[0] = ev.u16(0);
+      f[1] = ev.u16(2);
+      f[2] = ev.u16(4);
+      f[3] = ev.u8(6);
+      nf = 4;
+      break;
+    case TEL_PROFILE:
+      f[0] = ev.u32(1);
+      f[1] = ev.u32(5);
+      f[2] = ev.u32(9);
+      nf = 3;
+      t = NAME(slot_names, ev.u8(0));
+      break;
+    case TEL_REPLY:
+      f[0] = ev.u8(0);
+      nf = 1;
+      t = reply_word(ev);
+      break;
+    case TEL_PREFS:
+      t = all_prefs(ev);
+      break;
+    case TEL_STATS:
+      f[0] = ev.u16(1);
+      f[1] = ev.u16(3);
+      f[2] = ev.u16(5);
+      f[3] = ev.u8(0);
+      nf = 4;
+      t = std::to_string(ev.u16(7)) + '/' + std::to_string(ev.u16(9)) + '/' + std::to_string(ev.u16(11));
+      break;
+    case TEL_MEM:
+      f[0] = ev.u16(5);
+      f[1] = ev.u16(7);
+      f[2] = ev.u16(9);
+      f[3] = ev.u16(1);
+      nf = 4;
+      t = ev.u8(0) ? "measured" : "";
+      break;
+  }
+
+  std::string row = std::to_string(ev.ms) + ',' + tele_name(ev.id);
+  for (int i = 0; i < 4; i++) {
+    row += ',';
+    if (i < nf) row += std::to_string(f[i]);
+  }
+  row += ",\"";
+  for (char c : t) {
+    if (c == '"') row += '"';
+    row += c;
+  }
+  row += '"';
+  return row;
+}
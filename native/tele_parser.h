@@ -0,0 +1,59 @@
+/****************************************
+  Host side decoder for the sketch's binary telemetry (see
+  cw-trainer/TeleProto.h).
+
+  feed() takes the serial stream in pieces of any size and calls back
+  once per good frame. A frame with a bad check byte, or noise between
+  frames, costs only the bytes up to the next sync byte that starts a
+  good frame, and is counted. The millis() stamp is widened to 64 bits
+  across its 49 day wrap.
+
+  tele_log() and tele_csv() format an event as a log line or a CSV row.
+*****************************************/
+
+#ifndef tele_parser_h
+#define tele_parser_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "TeleProto.h"
+
+struct TeleEvent {
+  uint8_t id;
+  uint64_t ms;            // sketch millis(), unwrapped
+  uint8_t len;
+  const uint8_t *data;    // payload, only valid during the callback
+
+  unsigned u8(size_t at) const { return at < len ? data[at] : 0; }
+  unsigned u16(size_t at) const { return u8(at) | u8(at + 1) << 8; }
+  unsigned long u32(size_t at) const { return u16(at) | (unsigned long)u16(at + 2) << 16; }
+};
+
+class TeleParser
+{
+  public:
+    TeleParser(std::function<void(const TeleEvent &)> onEvent);
+    void feed(const uint8_t *data, size_t len);
+
+    unsigned long frames() const { return nFrames; }
+    unsigned long badBytes() const { return nBad; }       // skipped while resyncing
+    unsigned long dropped() const { return nDropped; }    // reported by TEL_DROPPED
+
+  private:
+    std::function<void(const TeleEvent &)> onEvent;
+    std::vector<uint8_t> buf;
+    uint32_t lastMs;
+    uint64_t wraps;
+    unsigned long nFrames, nBad, nDropped;
+};
+
+const char *tele_name(uint8_t id);
+std::string tele_log(const TeleEvent &ev);
+const char *tele_csv_header();
+std::string tele_csv(const TeleEvent &ev);
+
+#endif
@@ -0,0 +1,102 @@
+/****************************************
+  Bank of CW tone detectors for multi-signal decoding.
+  See tone_bank.h for a description.
+*****************************************/
+
+#include <math.h>
+
+#include "tone_bank.h"
+
+ToneBank::ToneBank(const BankConfig &c) : cfg(c)
+{
+  winLen = (size_t)lround(2.0 * cfg.rate / cfg.spacing / 4) * 4;
+  if (winLen < 16) winLen = 16;
+  hopLen = winLen / 4;
+
+  window.resize(winLen);
+  for (size_t i = 0; i < winLen; i++) window[i] = 0.5f * (1 - cos(2 * M_PI * (i + 0.5) / winLen));
+  ring.assign(winLen, 0);
+  ringPos = 0;
+  block.resize(winLen);
+
+  double hopSec = (double)hopLen / cfg.rate;
+  noiseRise = (float)pow(10, 0.1 * hopSec);     // 1 dB a second
+  peakDecay = (float)pow(0.5, hopSec / 3);      // halves in 3 s
+  onRatio = (float)pow(10, cfg.snrDb / 10);
+  rangeRatio = (float)pow(10, cfg.rangeDb / 10);
+  minPower = 32767.0f * 1e-4f * 32767.0f * 1e-4f;  // -80 dB full scale
+
+  for (double f = cfg.low; f <= cfg.high + 0.01 && f < cfg.rate / 2.0; f += cfg.spacing) {
+    Channel ch;
+    ch.freq = f;
+    ch.coeff = (float)(2 * cos(2 * M_PI * f / cfg.rate));
+    ch.power = ch.noise = ch.peak = minPower;
+    ch.keyed = ch.rising = false;
+    chans.push_back(ch);
+  }
+  primed = false;
+}
+
+double ToneBank::snr(size_t ch) const
+{
+  return 10 * log10(chans[ch].peak / chans[ch].noise);
+}
+
+void ToneBank::update(const int16_t *x)
+{
+  for (size_t i = 0; i < hopLen; i++) {
+    ring[ringPos] = x[i];
+    if (++ringPos == winLen) {
+      ringPos = 0;
+      primed = true;   // from here on the ring holds real audio
+    }
+  }
+  for (size_t i = 0, j = ringPos; i < winLen; i++) {
+    block[i] = ring[j] * window[i];
+    if (++j == winLen) j = 0;
+  }
+
+  // A full scale sine on a channel gives 32767^2: the Hann window
+  // halves the Goertzel magnitude of N/2 per unit amplitude
+  float norm = 16.0f / ((float)winLen * winLen);
+  for (Channel &ch : chans) {
+    float s1 = 0, s2 = 0;
+    for (size_t i = 0; i < winLen; i++) {
+      float s = block[i] + ch.coeff * s1 - s2;
+      s2 = s1;
+      s1 = s;
+    }
+    ch.power = (s1 * s1 + s2 * s2 - ch.coeff * s1 * s2) * norm;
+    if (!primed) continue;
+
+    if (ch.power < ch.noise) ch.noise += (ch.power - ch.noise) * 0.25f;
+    else ch.noise *= noiseRise;
+    if (ch.noise < minPower) ch.noise = minPower;
+    if (ch.power > ch.peak) ch.peak = ch.power;
+    else ch.peak *= peakDecay;
+    if (ch.peak < ch.noise) ch.peak = ch.noise;
+  }
+  if (!primed) return;
+
+  float strongest = 0;
+  for (const Channel &ch : chans) {
+    if (ch.peak > strongest) strongest = ch.peak;
+  }
+  float least = strongest / rangeRatio;
+  for (size_t i = 0; i < chans.size(); i++) {
+    Channel &ch = chans[i];
+    bool top = (i == 0 || ch.peak >= chans[i-1].peak) &&
+               (i + 1 == chans.size() || ch.peak >= chans[i+1].peak) && ch.peak >= least;
+    if (!ch.keyed) {
+      // Two blocks running: a strong carrier's first edge splatters
+      // over the band for a block, before its peak sets the range
+      bool on = top && ch.power > ch.noise * onRatio && ch.power > ch.peak / 3;
+      ch.keyed = on && ch.rising;
+      ch.rising = on;
+    } else {
+      float off = ch.noise * onRatio / 2;
+      if (off < ch.peak / 5) off = ch.peak / 5;
+      ch.keyed = top && ch.power >= off;
+    }
+  }
+}
@@ -0,0 +1,71 @@
+/****************************************
+  Bank of CW tone detectors for multi-signal decoding.
+
+  Channels sit every `spacing` Hz from `low` to `high`. Every hop() new
+  samples, the last 4 * hop() samples are Hann windowed and each
+  channel's power is taken with the Goertzel recurrence, so a sample
+  costs one multiply-add per channel. The window is two channel
+  spacings wide in frequency, which puts the next channel on its null,
+  and a carrier between two channels still reaches both at -6 dB.
+
+  Each channel follows its own noise floor (quick to fall, slow to
+  rise) and the peak level of its signal (slow to decay). It keys down
+  when its power is snrDb over the floor and past a third of the peak
+  for two blocks running, and up again below a fifth of the peak, or
+  the on threshold halved.
+  A channel only keys while its peak is at least that of both
+  neighbours, so one carrier gives one keyed channel, and within
+  rangeDb of the strongest channel's peak. The noise floors are held
+  above -80 dB full scale, so on clean audio a tone's harmonics and
+  spurs would be well over their floors; the range keeps them out.
+*****************************************/
+
+#ifndef tone_bank_h
+#define tone_bank_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+struct BankConfig {
+  unsigned rate = 8000;       // samples per second
+  double low = 300;           // lowest channel, Hz
+  double high = 2700;         // highest channel, Hz
+  double spacing = 100;       // Hz between channels
+  double snrDb = 12;          // key down this far over the noise floor
+  double rangeDb = 35;        // and no further below the strongest channel's peak
+};
+
+class ToneBank
+{
+  public:
+    ToneBank(const BankConfig &cfg);
+    size_t channels() const { return chans.size(); }
+    double frequency(size_t ch) const { return chans[ch].freq; }
+    size_t hop() const { return hopLen; }
+    void update(const int16_t *x);           // the next hop() samples
+    bool keyed(size_t ch) const { return chans[ch].keyed; }
+    double snr(size_t ch) const;             // peak over noise floor, dB
+
+  private:
+    struct Channel {
+      double freq;
+      float coeff;            // 2 cos(w) for the Goertzel recurrence
+      float power;            // last block, full scale sine = 32767^2
+      float noise;
+      float peak;
+      bool keyed;
+      bool rising;            // met the key down test on the last block
+    };
+    BankConfig cfg;
+    size_t winLen, hopLen;
+    float noiseRise, peakDecay, onRatio, rangeRatio, minPower;
+    std::vector<float> window;
+    std::vector<float> ring;    // last winLen samples
+    size_t ringPos;
+    std::vector<float> block;   // windowed copy of ring, oldest first
+    std::vector<Channel> chans;
+    bool primed;                // noise floors set from the first block
+};
+
+#endif
@@ -0,0 +1,147 @@
+/****************************************
+  Shaped CW audio for the native build.
+  See tone_renderer.h for a description.
+*****************************************/
+
+#include <math.h>
+#include <string.h>
+
+#include "ArduinoHal.h"
+#include "tone_renderer.h"
+
+ToneRenderer::ToneRenderer(const ToneConfig &c) : cfg(c)
+{
+  // One cycle and the first entry again, to interpolate towards
+  sine.resize((1 << SINE_BITS) + 1);
+  for (size_t i = 0; i < sine.size(); i++) {
+    sine[i] = (int16_t)lround(32767 * cfg.level * sin(2 * M_PI * i / (1 << SINE_BITS)));
+  }
+
+  size_t n = (size_t)lround(cfg.riseMs * cfg.rate / 1000);
+  envelope.resize(n + 1);
+  for (size_t i = 0; i <= n; i++) {
+    envelope[i] = n ? (uint16_t)lround(65535 * 0.5 * (1 - cos(M_PI * i / n))) : 65535;
+  }
+
+  phase = 0;
+  phaseStep = (uint32_t)lround(cfg.pitch * 4294967296.0 / cfg.rate);
+  env = 0;
+  down = false;
+  t0 = hal::now_us();
+}
+
+void ToneRenderer::key(bool d, uint64_t t_us)
+{
+  renderTo(t_us);
+  down = d;
+}
+
+void ToneRenderer::renderTo(uint64_t t_us)
+{
+  if (t_us < t0) return;
+  size_t end = (size_t)((t_us - t0) * cfg.rate / 1000000);
+  size_t top = envelope.size() - 1;
+
+  while (pcm.size() < end) {
+    if (down && env < top) env++;
+    else if (!down && env > 0) env--;
+    if (env == 0) {
+      pcm.push_back(0);
+      phase = 0;   // every mark starts at a zero crossing
+      continue;
+    }
+    // Linear interpolation between table entries: truncating the phase
+    // to the table would leave spurs at about -60 dBc
+    uint32_t i = phase >> (32 - SINE_BITS);
+    int32_t frac = (phase >> (16 - SINE_BITS)) & 0xFFFF;
+    int32_t s = sine[i] + (((sine[i+1] - sine[i]) * frac) >> 16);
+    pcm.push_back((int16_t)((s * envelope[env]) >> 16));
+    phase += phaseStep;
+  }
+}
+
+
+AudioEncoder::AudioEncoder(ToneRenderer &o, int encodePin, MorseSpeaker *Spkr_p)
+  : MorseEncoder(encodePin, Spkr_p), out(o)
+{
+}
+
+void AudioEncoder::start_signal(bool startOfChar, char signalType)
+{
+  MorseEncoder::start_signal(startOfChar, signalType);
+  out.key(true, hal::now_us());
+}
+
+void AudioEncoder::stop_signal(bool endOfChar, char signalType)
+{
+  MorseEncoder::stop_signal(endOfChar, signalType);
+  out.key(false, hal::now_us());
+}
+
+
+static void put16(FILE *f, uint16_t v)
+{
+  fputc(v & 0xFF, f);
+  fputc(v >> 8, f);
+}
+
+static void put32(FILE *f, uint32_t v)
+{
+  put16(f, v & 0xFFFF);
+  put16(f, v >> 16);
+}
+
+bool write_wav(FILE *f, const int16_t *pcm, size_t n, unsigned rate)
+{
+  uint32_t bytes = n * 2;
+  fwrite("RIFF", 1, 4, f);
+  put32(f, 36 + bytes);
+  fwrite("WAVEfmt ", 1, 8, f);
+  put32(f, 16);         // fmt chunk size
+  put16(f, 1);          // PCM
+  put16(f, 1);          // mono
+  put32(f, rate);
+  put32(f, rate * 2);   // bytes per second
+  put16(f, 2);          // block align
+  put16(f, 16);         // bits per sample
+  fwrite("data", 1, 4, f);
+  put32(f, bytes);
+  for (size_t i = 0; i < n; i++) put16(f, (uint16_t)pcm[i]);
+  return !ferror(f);
+}
+
+static uint32_t le(const uint8_t *p, int bytes)
+{
+  uint32_t v = 0;
+  for (int i = bytes - 1; i >= 0; i--) v = v << 8 | p[i];
+  return v;
+}
+
+bool read_wav(FILE *f, std::vector<int16_t> &pcm, unsigned &rate)
+{
+  uint8_t head[12], chunk[8], fmt[16];
+  unsigned channels = 0;
+
+  if (fread(head, 1, 12, f) != 12 || memcmp(head, "RIFF", 4) || memcmp(head + 8, "WAVE", 4)) return false;
+  while (fread(chunk, 1, 8, f) == 8) {
+    uint32_t len = le(chunk + 4, 4);
+    if (!memcmp(chunk, "fmt ", 4) && len >= 16) {
+      if (fread(fmt, 1, 16, f) != 16) return false;
+      if (le(fmt, 2) != 1 || le(fmt + 14, 2) != 16) return false;
+      channels = le(fmt + 2, 2);
+      rate = le(fmt + 4, 4);
+      len -= 16;
+    } else if (!memcmp(chunk, "data", 4) && channels) {
+      std::vector<uint8_t> d(len);
+      d.resize(fread(d.data(), 1, len, f));
+      for (size_t i = 0; i + 2 * channels <= d.size(); i += 2 * channels) {
+        pcm.push_back((int16_t)le(&d[i], 2));
+      }
+      return rate > 0;
+    }
+    for (uint32_t skip = len + (len & 1); skip > 0; skip--) {  // no fseek(), f may be a pipe
+      if (fgetc(f) == EOF) return false;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,71 @@
+/****************************************
+  Shaped CW audio for the native build.
+
+  ToneRenderer turns key up/down times into 16 bit PCM. Each mark
+  rises and falls along a raised cosine instead of switching on and
+  off, so there are no clicks, and the tone comes from a sine table
+  stepped by a phase accumulator and interpolated between entries,
+  which keeps spurs near -80 dBc where 16 bit rounding takes over.
+  Both tables are built once, so a sample costs three lookups and two
+  multiplies.
+
+  AudioEncoder is a MorseEncoder that keys a ToneRenderer instead of a
+  pin. Run it on the HAL's virtual clock and the audio has exactly the
+  timing the trainer sends with, rendered far faster than real time.
+*****************************************/
+
+#ifndef tone_renderer_h
+#define tone_renderer_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <vector>
+
+#include <MorseEnDecoder.h>
+
+struct ToneConfig {
+  unsigned rate = 8000;       // samples per second
+  double pitch = 700;         // Hz
+  double riseMs = 5;          // 10-90% of the raised cosine edge is about 0.6 of this
+  double level = 0.5;         // peak amplitude, fraction of full scale
+};
+
+class ToneRenderer
+{
+  public:
+    ToneRenderer(const ToneConfig &cfg);
+    void key(bool down, uint64_t t_us);   // key changes state at t_us
+    void renderTo(uint64_t t_us);         // produce samples up to t_us
+    std::vector<int16_t> &samples() { return pcm; }
+    unsigned rate() const { return cfg.rate; }
+
+  private:
+    static const int SINE_BITS = 10;
+    ToneConfig cfg;
+    std::vector<int16_t> sine;      // one cycle and its first entry again
+    std::vector<uint16_t> envelope; // rise, 0..65535
+    uint32_t phase;
+    uint32_t phaseStep;
+    size_t env;                     // position on the envelope, 0 = silent
+    bool down;
+    uint64_t t0;                    // time of sample 0
+    std::vector<int16_t> pcm;
+};
+
+class AudioEncoder : public MorseEncoder
+{
+  public:
+    AudioEncoder(ToneRenderer &out, int encodePin, MorseSpeaker *Spkr_p);
+  protected:
+    void start_signal(bool startOfChar, char signalType) override;
+    void stop_signal(bool endOfChar, char signalType) override;
+  private:
+    ToneRenderer &out;
+};
+
+// 16 bit mono WAV. read_wav() takes the first channel of a multi
+// channel file and fails on anything but 16 bit PCM.
+bool write_wav(FILE *f, const int16_t *pcm, size_t n, unsigned rate);
+bool read_wav(FILE *f, std::vector<int16_t> &pcm, unsigned &rate);
+
+#endif
@@ -0,0 +1,245 @@
+/****************************************
+  Simulated student for the virtual time runner.
+  See trainee.h for a description.
+*****************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Arduino.h"
+#include "ArduinoHal.h"
+#include "GroupAligner.h"
+#include "MorseCode.h"
+#include "trainee.h"
+
+Trainee::Trainee(const TraineeConfig &c) : cfg(c), rng(c.seed)
+{
+  dotMs = 60;   // 20 wpm until the first elements are heard
+  keyDown = false;
+  lastEdge = 0;
+  gen = 0;
+  groups = sentChars = 0;
+  keyedSubs = keyedIns = keyedDels = 0;
+  lastSubs = lastIns = lastDels = 0;
+  rounds = perfect = 0;
+  subs = ins = dels = 0;
+  lastDistance = 0;
+  scored = false;
+  repeatOk = repeatMissed = 0;
+}
+
+void Trainee::attach()
+{
+  hal::set_input(cfg.keyPin, HIGH);  // key up
+  hal::set_input(cfg.dashPin, HIGH);
+  hal::on_output([this](uint8_t pin, int level, uint64_t t) {
+    if (pin == cfg.listenPin) edge(level, t);
+  });
+}
+
+char Trainee::decodeElements(const std::string &elements)
+{
+  if (elements.size() > MORSE_MAX_ELEMENTS) return '#';
+  MorseCode code = MORSE_EMPTY;
+  for (char e : elements) code = code * 2 + (e == '-');
+  return morseDecode(code);
+}
+
+std::string Trainee::encodeChar(char c)
+{
+  std::string elements;
+  MorseCode code = morseEncode(c);
+  for (int i = morseLength(code) - 1; i >= 0; i--) elements += ((code >> i) & 1) ? '-' : '.';
+  return elements;
+}
+
+// Copy the sender from its key edges. The dot length estimate follows
+// every mark and every gap inside a character, so speed changes made
+// during the session are picked up within a few elements.
+void Trainee::edge(int level, uint64_t t)
+{
+  double ms = (t - lastEdge) / 1000.0;
+
+  if (level == HIGH && !keyDown) {
+    if (lastEdge && ms < 2 * dotMs) {
+      dotMs += (ms - dotMs) / 4;       // element space
+    } else {
+      endChar();
+    }
+    keyDown = true;
+  } else if (level == LOW && keyDown) {
+    if (ms < 2 * dotMs) {
+      elements += '.';
+      dotMs += (ms - dotMs) / 4;
+    } else {
+      elements += '-';
+      dotMs += (ms / 3 - dotMs) / 4;
+    }
+    keyDown = false;
+
+    // Five dots of silence ends the group
+    unsigned g = ++gen;
+    hal::schedule(t + (uint64_t)(5 * dotMs * 1000), [this, g]() { groupDone(g); });
+  }
+  lastEdge = t;
+}
+
+void Trainee::endChar()
+{
+  if (elements.empty()) return;
+  group += decodeElements(elements);
+  elements.clear();
+}
+
+void Trainee::groupDone(unsigned g)
+{
+  if (g != gen || keyDown) return;  // the sender carried on
+  endChar();
+  if (group.empty()) return;
+
+  // A missed group should come round again
+  if (scored && lastDistance > 0) {
+    if (group == lastGroup) repeatOk++; else repeatMissed++;
+  }
+  scored = false;
+  groups++;
+  sentChars += group.size();
+  reply();
+  lastGroup = group;
+  group.clear();
+}
+
+double Trainee::vary(double ms)
+{
+  std::uniform_real_distribution<double> u(-cfg.jitter, cfg.jitter);
+  return ms * (1 + u(rng));
+}
+
+// Key the copied group back, with mistakes
+void Trainee::reply()
+{
+  static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+  std::uniform_real_distribution<double> u(0, 1);
+  std::uniform_int_distribution<int> pick(0, sizeof(alphabet) - 2);
+  std::string text;
+
+  for (char c : group) {
+    if (u(rng) >= cfg.errorRate) {
+      text += c;
+      continue;
+    }
+    switch (rng() % 3) {
+      case 0: {  // substitute
+        char s;
+        do s = alphabet[pick(rng)]; while (s == c);
+        text += s;
+        break;
+      }
+      case 1:    // drop
+        break;
+      default:   // extra character
+        text += c;
+        text += alphabet[pick(rng)];
+    }
+  }
+  if (text.empty()) text = group.substr(0, 1);  // the trainer waits for at least one character
+
+  // Count what was keyed, not what was meant: a drop can be undone
+  // above, and an extra character can repeat the one it follows
+  GroupAligner keyed;
+  keyed.begin(group.c_str());
+  for (char c : text) keyed.add(c);
+  lastSubs = keyed.subs();
+  lastIns = keyed.inserts();
+  lastDels = keyed.deletes();
+  keyedSubs += lastSubs;
+  keyedIns += lastIns;
+  keyedDels += lastDels;
+
+  double wpm = 1200 / dotMs + cfg.speedOffset;
+  if (wpm < 5) wpm = 5;
+  double dot = 1200 / wpm;
+  uint64_t t = hal::now_us() + (uint64_t)(vary(cfg.reactMs) * 1000);
+  uint8_t pin = cfg.keyPin;
+
+  if (cfg.paddles) {
+    // Change paddles halfway through the last element of each run, the
+    // keyer remembers the new one and finishes the old
+    for (size_t i = 0; i < text.size(); i++) {
+      std::string code = encodeChar(text[i]);
+      uint64_t press = t;
+      for (int j = 0; code[j]; j++) {
+        double len = (code[j] == '.') ? dot : 3 * dot;
+        if (code[j+1] != code[j]) {
+          uint8_t p = (code[j] == '.') ? cfg.keyPin : cfg.dashPin;
+          uint64_t release = t + (uint64_t)(vary(len / 2) * 1000);
+          hal::schedule(press, [p]() { hal::set_input(p, LOW); });
+          hal::schedule(release, [p]() { hal::set_input(p, HIGH); });
+          press = release;
+        }
+        t += (uint64_t)((len + dot) * 1000);
+      }
+      t += (uint64_t)(vary(2 * dot) * 1000);
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < text.size(); i++) {
+    std::string code = encodeChar(text[i]);
+    for (int j = 0; code[j]; j++) {
+      hal::schedule(t, [pin]() { hal::set_input(pin, LOW); });
+      t += (uint64_t)(vary(code[j] == '.' ? dot : 3 * dot) * 1000);
+      hal::schedule(t, [pin]() { hal::set_input(pin, HIGH); });
+      t += (uint64_t)(vary(code[j+1] ? dot : 3 * dot) * 1000);
+    }
+  }
+}
+
+// Trainer telemetry, only the scores matter here
+void Trainee::event(const TeleEvent &ev)
+{
+  if (ev.id != TEL_SCORE) return;
+  rounds++;
+  subs += ev.u8(0);
+  ins += ev.u8(1);
+  dels += ev.u8(2);
+  lastDistance = ev.u8(0) + ev.u8(1) + ev.u8(2);
+  scored = true;
+  if (lastDistance == 0) perfect++;
+}
+
+void Trainee::print(FILE *f)
+{
+  unsigned errors = subs + ins + dels;
+  fprintf(f, "Trainee: %u groups, %u characters, %u errors keyed, S/I/D = %u/%u/%u\n", groups, sentChars,
+          keyedSubs + keyedIns + keyedDels, keyedSubs, keyedIns, keyedDels);
+  fprintf(f, "Scored:  %u rounds, %u perfect (%.1f%%), S/I/D = %u/%u/%u, accuracy %.1f%%\n",
+          rounds, perfect, rounds ? 100.0 * perfect / rounds : 0.0, subs, ins, dels,
+          sentChars ? 100.0 * (sentChars > errors ? sentChars - errors : 0) / sentChars : 0.0);
+  fprintf(f, "Repeats: %u missed groups sent again, %u not repeated\n", repeatOk, repeatMissed);
+}
+
+// For a run under test: the trainer must score exactly the errors that
+// were keyed, and finish a round every few seconds. A stalled trainer,
+// as at a mishandled millis() wrap, fails the second. A reply the run
+// ended before the trainer scored is left out.
+bool Trainee::check(FILE *f, double seconds)
+{
+  bool ok = true;
+  unsigned s = keyedSubs, i = keyedIns, d = keyedDels;
+  if (groups > rounds) {
+    s -= lastSubs;
+    i -= lastIns;
+    d -= lastDels;
+  }
+  if (subs != s || ins != i || dels != d) {
+    fprintf(f, "Check:   trainer scored S/I/D = %u/%u/%u, the trainee keyed %u/%u/%u\n",
+            subs, ins, dels, s, i, d);
+    ok = false;
+  }
+  if (rounds < seconds / 5) {
+    fprintf(f, "Check:   %u rounds in %.0f s, fewer than one every 5 s\n", rounds, seconds);
+    ok = false;
+  }
+  return ok;
+}
@@ -0,0 +1,84 @@
+/****************************************
+  Simulated student for the virtual time runner.
+
+  Listens to the trainer's keyed output, copies each group by its
+  timing, and once the group has ended keys a reply on the morse input
+  after a reaction delay. The reply can have copying errors
+  (substituted, dropped or extra characters), a speed offset from the
+  sender and random timing jitter. With paddles set the reply is
+  keyed on iambic paddles instead: each paddle is held from the start
+  of its run of elements to the middle of the run's last one, and the
+  trainer's keyer does the timing.
+
+  Each reply is scored against the copied group with the trainer's own
+  GroupAligner, and the trainer's TEL_SCORE telemetry events are
+  collected, so a run can be checked against what the trainee actually
+  keyed, including whether a missed group is repeated.
+*****************************************/
+
+#ifndef trainee_h
+#define trainee_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <random>
+#include <string>
+
+#include "tele_parser.h"
+
+struct TraineeConfig {
+  uint8_t listenPin = 12;     // trainer key output
+  uint8_t keyPin = 2;         // trainer morse input, active low, or the dot paddle
+  uint8_t dashPin = 3;        // dash paddle, active low
+  bool paddles = false;       // key replies on paddles, not a straight key
+  double errorRate = 0.05;    // chance of a copying error per character
+  double reactMs = 400;       // group end to first key down
+  double speedOffset = 0;     // reply speed minus sending speed, wpm
+  double jitter = 0.1;        // element timing error, fraction of its length
+  unsigned long seed = 1;
+};
+
+class Trainee
+{
+  public:
+    Trainee(const TraineeConfig &cfg);
+    void attach();                                // start listening to the trainer
+    void event(const TeleEvent &ev);              // trainer telemetry
+    void print(FILE *f);                          // session report
+    bool check(FILE *f, double seconds);          // scores match the keying, rounds kept coming
+
+  private:
+    void edge(int level, uint64_t t);
+    void endChar();
+    void groupDone(unsigned gen);
+    void reply();
+    double vary(double ms);
+    static char decodeElements(const std::string &elements);
+    static std::string encodeChar(char c);
+
+    TraineeConfig cfg;
+    std::mt19937 rng;
+
+    // Copying the trainer
+    double dotMs;             // running estimate of the sender's dot length
+    bool keyDown;
+    uint64_t lastEdge;
+    unsigned gen;             // bumped on every edge, stale timeouts are ignored
+    std::string elements;     // dots and dashes of the current character
+    std::string group;        // characters copied so far
+    std::string lastGroup;
+
+    // Session totals
+    unsigned groups;
+    unsigned sentChars;
+    unsigned keyedSubs, keyedIns, keyedDels;  // replies against the copied groups
+    unsigned lastSubs, lastIns, lastDels;     // the latest reply alone
+    unsigned rounds;          // rounds scored by the trainer
+    unsigned perfect;
+    unsigned subs, ins, dels;
+    unsigned lastDistance;
+    bool scored;              // the last group was scored
+    unsigned repeatOk, repeatMissed, repeatWrong;
+};
+
+#endif
@@ -0,0 +1,64 @@
+/****************************************
+  Work-stealing thread pool for the native tools.
+  See work_pool.h for a description.
+*****************************************/
+
+#include <exception>
+#include <thread>
+
+#include "work_pool.h"
+
+WorkPool::WorkPool(unsigned threads)
+{
+  nThreads = threads ? threads : std::thread::hardware_concurrency();
+  if (nThreads == 0) nThreads = 1;
+  for (unsigned i = 0; i < nThreads; i++) queues.emplace_back(new Queue);
+}
+
+// Own work from the front, stolen work from the back
+bool WorkPool::take(unsigned worker, size_t &task)
+{
+  {
+    Queue &q = *queues[worker];
+    std::lock_guard<std::mutex> g(q.lock);
+    if (!q.tasks.empty()) {
+      task = q.tasks.front();
+      q.tasks.pop_front();
+      return true;
+    }
+  }
+  for (unsigned i = 1; i < nThreads; i++) {
+    Queue &q = *queues[(worker + i) % nThreads];
+    std::lock_guard<std::mutex> g(q.lock);
+    if (!q.tasks.empty()) {
+      task = q.tasks.back();
+      q.tasks.pop_back();
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkPool::run(size_t tasks, std::function<void(size_t, unsigned)> fn)
+{
+  for (size_t t = 0; t < tasks; t++) queues[t % nThreads]->tasks.push_back(t);
+
+  std::exception_ptr error;
+  std::mutex errorLock;
+  std::vector<std::thread> workers;
+  for (unsigned w = 0; w < nThreads; w++) {
+    workers.emplace_back([&, w]() {
+      size_t task;
+      while (take(w, task)) {
+        try {
+          fn(task, w);
+        } catch (...) {
+          std::lock_guard<std::mutex> g(errorLock);
+          if (!error) error = std::current_exception();
+        }
+      }
+    });
+  }
+  for (std::thread &t : workers) t.join();
+  if (error) std::rethrow_exception(error);
+}
@@ -0,0 +1,42 @@
+/****************************************
+  Work-stealing thread pool for the native tools.
+
+  run() deals task numbers 0..n-1 round robin onto one deque per
+  worker. A worker works through its own deque from the front and,
+  when that is empty, steals from the back of the others, so uneven
+  tasks keep every core busy to the end while tasks still finish
+  roughly in order. Each worker thread has its own HAL instance (see
+  ArduinoHal.h), so tasks may run encoders and decoders freely.
+*****************************************/
+
+#ifndef work_pool_h
+#define work_pool_h
+
+#include <stddef.h>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class WorkPool
+{
+  public:
+    WorkPool(unsigned threads = 0);    // 0 = one per core
+    unsigned threads() const { return nThreads; }
+
+    // Call fn(task, worker) for every task, returns when all are done.
+    // An exception from a task is rethrown here after the others finish.
+    void run(size_t tasks, std::function<void(size_t task, unsigned worker)> fn);
+
+  private:
+    struct Queue {
+      std::mutex lock;
+      std::deque<size_t> tasks;
+    };
+    bool take(unsigned worker, size_t &task);
+    unsigned nThreads;
+    std::vector<std::unique_ptr<Queue>> queues;
+};
+
+#endif
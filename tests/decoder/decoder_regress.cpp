@@ -0,0 +1,649 @@
+/****************************************
+  MorseDecoder golden-file and timing regression suite.
+
+  Every *.fix file in the fixture directory is replayed through a
+  fresh MorseDecoder on the native HAL's virtual clock:
+    # comment
+    wpm N            decoder speed
+    text STRING      what was sent (for the copy rate only)
+    edges a,b,c,...  keyed mark,space,mark,... durations in ms (may repeat)
+    audio FILE.wav   or: 16 bit mono audio fed to the analog input
+    level DB         scale the audio
+    fade DB SECONDS  and fade it by up to DB and back, once a period
+    noise DB         and add white noise, rms DB below full scale
+
+  The decoded text must match NAME.golden exactly. With --beam the
+  fixtures go through MorseViterbi<32> instead and are checked against
+  NAME.beam.golden and baseline.beam.tsv. Each line also shows the copy
+  rate: one less the edit distance from the sent text over its length.
+
+  The decoder's confidence() in each character is averaged over the
+  fixture, and with its lowest value compared with margins.tsv
+  (margins.beam.tsv): a change that keeps the text but moves the
+  elements closer to the decision thresholds fails when either falls
+  by more than a few points. Margins are deterministic, so unlike the
+  timing they are kept with the golden files.
+
+  Audio fixtures are also run through the vectorised front end in
+  native/envelope.h with every instruction set the machine has. Its
+  key edges must be exactly those the decoder found sample by sample,
+  and fed back through MorseDecoder::edge() must give the same text
+  and confidence. The front end's speed over all the audio fixtures
+  at once is shown at the end.
+
+  A keyed fixture replays on a virtual clock that jumps from one of
+  the decoders' wake hints to the next, so decode() is called far less
+  often than on the board. Each one is replayed again with a poll at
+  least every millisecond, and must give the same text; otherwise a
+  change to when a decoder asks to be woken could move the goldens.
+
+  Without --beam every fixture is also decoded with early commit
+  (MorseDecoder::setEarly()). Its final characters must give the
+  golden text, or NAME.early.golden where they differ, which is where
+  a sender ran on past a character no longer one starts with. The
+  median time from the end of a character's last mark to its display,
+  provisional or final, is shown for both ways at the end.
+
+  The CPU time of the whole replay and the worst single decode() call
+  are compared with baseline.tsv and fail when more than the tolerance
+  above it. Replays are deterministic, so the total is the best of
+  several runs and every decode() call is timed as its best over the
+  same runs; an interrupt landing in one run does not count as a
+  regression. Timing baselines belong to the machine they were
+  recorded on: re-record with --update after moving to a new one, or
+  run with --no-timing.
+
+  Usage: decoder_regress [--dir DIR] [--beam] [--update] [--no-timing] [--tolerance F]
+*****************************************/
+
+#include <dirent.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "ArduinoHal.h"
+#include <MorseEnDecoder.h>
+#include <MorseViterbi.h>
+#include "envelope.h"
+
+static const uint8_t key_pin = 2;      // keyed fixtures, active low
+static const uint8_t audio_pin = A0;   // audio fixtures
+static const uint64_t start_us = 1000000;   // virtual time a replay starts at
+static const int runs = 5;             // timing is the best of this many
+static const double cpu_floor_us = 500;   // slack for very short fixtures
+static const double worst_floor_ns = 2000;
+
+struct Fixture {
+  std::string name;
+  int wpm = 0;
+  std::string text;
+  std::vector<double> edges;
+  std::vector<int16_t> audio;
+  unsigned rate = 0;
+  double level = 0;       // dB
+  double fade = 0;        // dB
+  double fadePeriod = 0;  // s
+  double noise = 0;       // dB below full scale, 0 for none
+};
+
+struct Result {
+  std::string decoded;
+  std::vector<int> confidence;   // of every character but spaces
+  std::vector<AudioEdge> edges;  // the decoder's key edges, audio fixtures
+  std::vector<double> latency;   // ms from the end of each character to its display
+  double cpuUs;     // whole replay
+};
+
+struct Baseline {
+  double cpuUs;
+  double worstNs;
+};
+
+struct Margin {
+  double mean;
+  int low;
+};
+
+static const double mean_slack = 2;   // confidence points the margins may fall by
+static const int low_slack = 5;
+
+static std::string dir = "tests/decoder";
+static bool beam = false;
+static std::string suffix;   // ".beam" for the Viterbi decoder's files
+
+static bool read_file(const std::string &path, std::string &data)
+{
+  FILE *f = fopen(path.c_str(), "rb");
+  if (!f) return false;
+  char buf[4096];
+  size_t n;
+  data.clear();
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) data.append(buf, n);
+  fclose(f);
+  return true;
+}
+
+static uint32_t le32(const std::string &d, size_t i)
+{
+  return (uint8_t)d[i] | (uint8_t)d[i+1] << 8 | (uint8_t)d[i+2] << 16 | (uint32_t)(uint8_t)d[i+3] << 24;
+}
+
+// 16 bit mono PCM only
+static bool load_wav(const std::string &path, Fixture &fx)
+{
+  std::string d;
+  if (!read_file(path, d) || d.size() < 12 || d.compare(0, 4, "RIFF") || d.compare(8, 4, "WAVE")) return false;
+  bool fmtOk = false;
+  for (size_t i = 12; i + 8 <= d.size(); ) {
+    uint32_t len = le32(d, i + 4);
+    if (i + 8 + len > d.size()) return false;
+    if (!d.compare(i, 4, "fmt ") && len >= 16) {
+      fmtOk = (uint8_t)d[i+8] == 1 && (uint8_t)d[i+10] == 1 && (uint8_t)d[i+22] == 16;
+      fx.rate = le32(d, i + 12);
+    } else if (!d.compare(i, 4, "data") && fmtOk) {
+      for (size_t j = 0; j + 1 < len; j += 2) {
+        fx.audio.push_back((int16_t)((uint8_t)d[i+8+j] | (uint8_t)d[i+9+j] << 8));
+      }
+      return fx.rate > 0;
+    }
+    i += 8 + len + (len & 1);
+  }
+  return false;
+}
+
+// Level, fading and noise, applied once at load so they cost nothing
+// in the timed replay. The noise is the same on every run.
+static void shape_audio(Fixture &fx)
+{
+  uint32_t seed = 12345;
+  double sigma = fx.noise > 0 ? 32767 * pow(10, -fx.noise / 20) : 0;
+  for (size_t i = 0; i < fx.audio.size(); i++) {
+    double db = fx.level;
+    if (fx.fade > 0) db -= fx.fade * (1 - cos(2 * M_PI * i / (fx.fadePeriod * fx.rate))) / 2;
+    double v = fx.audio[i] * pow(10, db / 20);
+    if (sigma > 0) {
+      // Sum of 12 uniforms, near enough Gaussian
+      double u = -6;
+      for (int k = 0; k < 12; k++) {
+        seed = seed * 1664525 + 1013904223;
+        u += (seed >> 8) / 16777216.0;
+      }
+      v += u * sigma;
+    }
+    fx.audio[i] = (int16_t)std::max(-32767.0, std::min(32767.0, v));
+  }
+}
+
+static bool load_fixture(const std::string &name, Fixture &fx)
+{
+  std::string d;
+  if (!read_file(dir + "/" + name + ".fix", d)) return false;
+  fx.name = name;
+  size_t pos = 0;
+  while (pos < d.size()) {
+    size_t eol = d.find('\n', pos);
+    if (eol == std::string::npos) eol = d.size();
+    std::string line = d.substr(pos, eol - pos);
+    pos = eol + 1;
+    if (line.empty() || line[0] == '#') continue;
+    size_t sp = line.find(' ');
+    std::string key = line.substr(0, sp);
+    std::string val = (sp == std::string::npos) ? "" : line.substr(sp + 1);
+    if (key == "wpm") {
+      fx.wpm = atoi(val.c_str());
+    } else if (key == "text") {
+      fx.text = val;
+    } else if (key == "edges") {
+      for (const char *p = val.c_str(); *p; ) {
+        char *end;
+        fx.edges.push_back(strtod(p, &end));
+        if (end == p) return false;
+        p = (*end == ',') ? end + 1 : end;
+      }
+    } else if (key == "audio") {
+      if (!load_wav(dir + "/" + val, fx)) return false;
+    } else if (key == "level") {
+      fx.level = atof(val.c_str());
+    } else if (key == "fade") {
+      if (sscanf(val.c_str(), "%lf %lf", &fx.fade, &fx.fadePeriod) != 2 || fx.fadePeriod <= 0) return false;
+    } else if (key == "noise") {
+      fx.noise = atof(val.c_str());
+      if (fx.noise <= 0) return false;
+    } else {
+      return false;
+    }
+  }
+  if (!fx.audio.empty()) shape_audio(fx);
+  return fx.wpm > 0 && (!fx.edges.empty() || !fx.audio.empty());
+}
+
+static double thread_cpu_us()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// One replay. With calls given, every decode() call is timed and
+// calls[i] keeps the best time of the i'th call. That adds enough
+// overhead that the CPU total is taken from a separate run. With
+// edges given, an audio fixture is replayed from those instead of its
+// samples, through MorseDecoder::edge(). With early, the decoder
+// runs with early commit; only final characters make the text. With
+// dense, the clock moves at most 1 ms between polls of a keyed fixture
+// instead of jumping to the decoders' wake hints.
+static Result replay(const Fixture &fx, std::vector<double> *calls = NULL,
+                     const std::vector<AudioEdge> *edges = NULL, bool early = false,
+                     bool dense = false)
+{
+  Result r;
+  size_t n_call = 0;
+  hal::reset();
+  hal::set_virtual_time(start_us, 0, dense ? 1000 : 0);
+
+  bool sampled = !fx.audio.empty() && !edges;
+  MorseSpeaker spkr(11);
+  MorseDecoder dec(sampled ? audio_pin : key_pin, sampled ? MORSE_AUDIO : MORSE_KEYER, MORSE_ACTIVE_LOW, &spkr);
+  MorseViterbi<32> vit(&dec);
+  dec.setspeed(fx.wpm);
+  dec.setEarly(early);
+  vit.setspeed(fx.wpm);
+  char shown = '\0';     // provisional character on display
+  double shownMs = 0;    // and how long after its last mark it went up
+
+  auto decode = [&]() {
+    if (beam) vit.decode();
+    else dec.decode();
+  };
+  auto step = [&]() {
+    if (calls) {
+      auto t0 = std::chrono::steady_clock::now();
+      decode();
+      double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+      if (n_call == calls->size()) calls->push_back(ns);
+      else if (ns < (*calls)[n_call]) (*calls)[n_call] = ns;
+      n_call++;
+    } else {
+      decode();
+    }
+    if (dec.morseSignalState != (r.edges.size() & 1)) {   // edges alternate, a mark first
+      bool mark = dec.morseSignalState;
+      r.edges.push_back(AudioEdge{hal::now_us(), mark ? dec.markStart() : dec.spaceStart(), mark});
+    }
+    char c = '\0';
+    int conf = 0;
+    if (beam && vit.available()) {
+      c = vit.read();
+      conf = vit.confidence();
+    }
+    if (!beam && dec.available()) {
+      c = dec.read();
+      conf = dec.confidence();
+    }
+    if (!c) return;
+    double ms = hal::now_us() / 1000.0 - dec.spaceStart();
+    if (!beam && dec.provisional()) {
+      shown = c;
+      shownMs = ms;
+      return;
+    }
+    r.decoded += c;
+    if (c == ' ') return;
+    r.confidence.push_back(conf);
+    r.latency.push_back((!beam && dec.replaces() && shown == c) ? shownMs : ms);
+  };
+
+  double cpu0 = thread_cpu_us();
+  if (fx.audio.empty()) {
+    // Key edges as scheduled inputs, the clock skips the waits
+    hal::set_input(key_pin, HIGH);
+    uint64_t t = 1100000;
+    for (size_t i = 0; i < fx.edges.size(); i++) {
+      bool level = (i % 2) != 0;   // marks pull the input low
+      hal::schedule(t, [level]() { hal::set_input(key_pin, level); });
+      t += (uint64_t)(fx.edges[i] * 1000);
+    }
+    hal::schedule(t, []() { hal::set_input(key_pin, HIGH); });
+    hal::set_end_time(t + 3000000);
+    try {
+      for (;;) step();
+    } catch (const hal::SimulationEnd &) {
+    }
+  } else if (edges) {
+    // The front end's edges, as they were seen
+    hal::set_input(key_pin, HIGH);
+    for (const AudioEdge &e : *edges) hal::schedule(e.at, [&dec, e]() { dec.edge(e.mark, e.start); });
+    hal::set_end_time(start_us + (fx.audio.size() + 3 * fx.rate) * 1000000 / fx.rate);
+    try {
+      for (;;) step();
+    } catch (const hal::SimulationEnd &) {
+    }
+  } else {
+    // Audio is sampled once per sample period, then 3 s of silence
+    uint64_t t0 = hal::now_us();
+    size_t n = fx.audio.size();
+    hal::set_analog_source([&](uint8_t, uint64_t t) {
+      size_t i = (t - t0) * fx.rate / 1000000;
+      return (i < n) ? pcm_to_adc(fx.audio[i]) : 512;
+    });
+    unsigned period = 1000000 / fx.rate;
+    for (size_t i = 0; i < n + 3 * fx.rate; i++) {
+      step();
+      delayMicroseconds(period);
+    }
+    hal::set_analog_source(nullptr);
+  }
+  r.cpuUs = thread_cpu_us() - cpu0;
+  return r;
+}
+
+// One less the edit distance from sent to decoded over the length
+// sent, ignoring trailing spaces
+static double copy_rate(std::string sent, std::string got)
+{
+  while (!got.empty() && got.back() == ' ') got.pop_back();
+  if (sent.empty()) return got.empty() ? 1 : 0;
+  std::vector<size_t> row(got.size() + 1);
+  for (size_t j = 0; j <= got.size(); j++) row[j] = j;
+  for (size_t i = 1; i <= sent.size(); i++) {
+    size_t diag = row[0];
+    row[0] = i;
+    for (size_t j = 1; j <= got.size(); j++) {
+      size_t up = row[j];
+      row[j] = std::min(std::min(row[j] + 1, row[j-1] + 1), diag + (sent[i-1] != got[j-1]));
+      diag = up;
+    }
+  }
+  return std::max(0.0, 1 - (double)row[got.size()] / sent.size());
+}
+
+static std::map<std::string, Baseline> load_baselines()
+{
+  std::map<std::string, Baseline> b;
+  FILE *f = fopen((dir + "/baseline" + suffix + ".tsv").c_str(), "r");
+  if (!f) return b;
+  char name[256];
+  double cpu, worst;
+  while (fscanf(f, "%255s %lf %lf", name, &cpu, &worst) == 3) b[name] = Baseline{cpu, worst};
+  fclose(f);
+  return b;
+}
+
+static Margin margin_of(const Result &r)
+{
+  Margin m{100, 100};
+  if (r.confidence.empty()) return m;
+  double sum = 0;
+  for (int c : r.confidence) {
+    sum += c;
+    m.low = std::min(m.low, c);
+  }
+  m.mean = sum / r.confidence.size();
+  return m;
+}
+
+static std::map<std::string, Margin> load_margins()
+{
+  std::map<std::string, Margin> m;
+  FILE *f = fopen((dir + "/margins" + suffix + ".tsv").c_str(), "r");
+  if (!f) return m;
+  char name[256];
+  double mean;
+  int low;
+  while (fscanf(f, "%255s %lf %d", name, &mean, &low) == 3) m[name] = Margin{mean, low};
+  fclose(f);
+  return m;
+}
+
+// All the audio fixtures side by side through the front end, for long
+// enough to time
+static void front_end_speed(const std::vector<Fixture> &audio)
+{
+  std::vector<AudioInput> in;
+  size_t length = 0;
+  for (const Fixture &fx : audio) {
+    in.push_back(AudioInput{fx.audio.data(), fx.audio.size(), fx.wpm});
+    length = std::max(length, fx.audio.size());
+  }
+  double seconds = (double)length * in.size() / audio[0].rate;
+  const char *isa = audio_edges_isas()[0];
+  int reps = 0;
+  double cpu0 = thread_cpu_us(), cpu;
+  do {
+    audio_edges(in, audio[0].rate, start_us, length, isa);
+    reps++;
+    cpu = thread_cpu_us() - cpu0;
+  } while (cpu < 100000);
+  printf("front end (%s): %zu recordings, %.1f s of audio, %.0fx real time per core\n",
+         isa, in.size(), seconds, seconds * reps * 1e6 / cpu);
+}
+
+static double median(std::vector<double> v)
+{
+  std::sort(v.begin(), v.end());
+  return v[v.size() / 2];
+}
+
+static std::vector<std::string> fixture_names()
+{
+  std::vector<std::string> names;
+  DIR *d = opendir(dir.c_str());
+  if (!d) return names;
+  while (struct dirent *e = readdir(d)) {
+    std::string n = e->d_name;
+    if (n.size() > 4 && n.compare(n.size() - 4, 4, ".fix") == 0) names.push_back(n.substr(0, n.size() - 4));
+  }
+  closedir(d);
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+int main(int argc, char **argv)
+{
+  bool update = false;
+  bool timing = true;
+  double tolerance = 0.5;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--dir") && i + 1 < argc) {
+      dir = argv[++i];
+    } else if (!strcmp(argv[i], "--update")) {
+      update = true;
+    } else if (!strcmp(argv[i], "--beam")) {
+      beam = true;
+      suffix = ".beam";
+    } else if (!strcmp(argv[i], "--no-timing")) {
+      timing = false;
+    } else if (!strcmp(argv[i], "--tolerance") && i + 1 < argc) {
+      tolerance = atof(argv[++i]);
+    } else {
+      fprintf(stderr, "Usage: %s [--dir DIR] [--beam] [--update] [--no-timing] [--tolerance F]\n", argv[0]);
+      return 2;
+    }
+  }
+
+  std::vector<std::string> names = fixture_names();
+  if (names.empty()) {
+    fprintf(stderr, "%s: no fixtures in %s\n", argv[0], dir.c_str());
+    return 2;
+  }
+  std::map<std::string, Baseline> base = load_baselines();
+  std::map<std::string, Baseline> now;
+  std::map<std::string, Margin> margins = load_margins();
+  std::map<std::string, Margin> marginsNow;
+  int failures = 0;
+  double copySum = 0;
+  std::vector<Fixture> audio;   // for the front end's speed
+  std::vector<double> latency, earlyLatency;   // of every character
+
+  for (const std::string &name : names) {
+    Fixture fx;
+    if (!load_fixture(name, fx)) {
+      printf("FAIL %-16s bad fixture\n", name.c_str());
+      failures++;
+      continue;
+    }
+
+    Result r = replay(fx);
+    std::string golden;
+    std::string goldenFile = dir + "/" + name + suffix + ".golden";
+    bool textOk;
+    if (update) {
+      FILE *f = fopen(goldenFile.c_str(), "w");
+      textOk = f && fputs((r.decoded + "\n").c_str(), f) >= 0;
+      if (f) textOk = (fclose(f) == 0) && textOk;
+    } else {
+      textOk = read_file(goldenFile, golden) && golden == r.decoded + "\n";
+    }
+
+    std::string note;
+    char buf[128];
+    Margin m = margin_of(r);
+    marginsNow[name] = m;
+    snprintf(buf, sizeof(buf), "  conf %.0f/%d", m.mean, m.low);
+    note = buf;
+    if (!update) {
+      auto b = margins.find(name);
+      if (b == margins.end()) {
+        note += "  (no margins)";
+        textOk = false;
+      } else if (m.mean < b->second.mean - mean_slack || m.low < b->second.low - low_slack) {
+        snprintf(buf, sizeof(buf), "  MARGINS NARROWED from %.0f/%d", b->second.mean, b->second.low);
+        note += buf;
+        textOk = false;
+      }
+    }
+
+    if (timing) {
+      Baseline best{r.cpuUs, 0};
+      std::vector<double> calls;
+      for (int i = 0; i < runs; i++) {
+        best.cpuUs = std::min(best.cpuUs, replay(fx).cpuUs);
+        replay(fx, &calls);
+      }
+      for (double ns : calls) best.worstNs = std::max(best.worstNs, ns);
+      now[name] = best;
+      snprintf(buf, sizeof(buf), "  cpu %.0f us  worst decode() %.0f ns", best.cpuUs, best.worstNs);
+      note += buf;
+      if (!update) {
+        auto b = base.find(name);
+        if (b == base.end()) {
+          note += "  (no baseline)";
+          textOk = false;
+        } else {
+          if (best.cpuUs > std::max(b->second.cpuUs * (1 + tolerance), b->second.cpuUs + cpu_floor_us)) {
+            snprintf(buf, sizeof(buf), "  CPU REGRESSED from %.0f us", b->second.cpuUs);
+            note += buf;
+            textOk = false;
+          }
+          if (best.worstNs > std::max(b->second.worstNs * (1 + tolerance), b->second.worstNs + worst_floor_ns)) {
+            snprintf(buf, sizeof(buf), "  LATENCY REGRESSED from %.0f ns", b->second.worstNs);
+            note += buf;
+            textOk = false;
+          }
+        }
+      }
+    }
+
+    if (!fx.audio.empty()) {
+      // The vectorised front end must find the same edges, and they the same text
+      AudioInput in{fx.audio.data(), fx.audio.size(), fx.wpm};
+      size_t length = fx.audio.size() + 3 * fx.rate;
+      for (const char *isa : audio_edges_isas()) {
+        if (audio_edges({in}, fx.rate, start_us, length, isa)[0] != r.edges) {
+          snprintf(buf, sizeof(buf), "  FRONT END (%s) DIFFERS", isa);
+          note += buf;
+          textOk = false;
+        }
+      }
+      Result e = replay(fx, NULL, &r.edges);
+      if (e.decoded != r.decoded || e.confidence != r.confidence) {
+        note += "  EDGE REPLAY DIFFERS";
+        textOk = false;
+      }
+      if (audio.empty() || audio[0].rate == fx.rate) audio.push_back(fx);
+    }
+
+    if (fx.audio.empty()) {
+      // The text must not depend on when decode() happens to be called
+      Result d = replay(fx, NULL, NULL, false, true);
+      if (d.decoded != r.decoded) {
+        note += "  POLL SCHEDULE DIFFERS \"" + d.decoded + "\"";
+        textOk = false;
+      }
+    }
+
+    latency.insert(latency.end(), r.latency.begin(), r.latency.end());
+    if (!beam) {
+      // Early commit must end with the same text, only sooner, except
+      // where a .early.golden file says otherwise
+      Result q = replay(fx, NULL, NULL, true);
+      std::string earlyFile = dir + "/" + name + ".early.golden";
+      if (update) {
+        if (q.decoded == r.decoded) {
+          remove(earlyFile.c_str());
+        } else {
+          FILE *f = fopen(earlyFile.c_str(), "w");
+          if (!f || fputs((q.decoded + "\n").c_str(), f) < 0) textOk = false;
+          if (f && fclose(f) != 0) textOk = false;
+        }
+      } else {
+        std::string expected;
+        if (!read_file(earlyFile, expected)) expected = golden;
+        if (expected != q.decoded + "\n") {
+          note += "  EARLY DIFFERS \"" + q.decoded + "\"";
+          textOk = false;
+        }
+      }
+      earlyLatency.insert(earlyLatency.end(), q.latency.begin(), q.latency.end());
+    }
+
+    double copy = copy_rate(fx.text, r.decoded);
+    copySum += copy;
+    printf("%s %-16s %3.0f%% \"%s\"%s\n", textOk ? "ok  " : "FAIL", name.c_str(), copy * 100, r.decoded.c_str(), note.c_str());
+    if (!update && golden != r.decoded + "\n") {
+      golden.erase(golden.find_last_not_of('\n') + 1);
+      printf("     expected \"%s\", sent \"%s\"\n", golden.c_str(), fx.text.c_str());
+    }
+    if (!textOk) failures++;
+  }
+
+  if (update) {
+    FILE *f = fopen((dir + "/margins" + suffix + ".tsv").c_str(), "w");
+    if (!f) {
+      perror("margins.tsv");
+      return 1;
+    }
+    for (auto &m : marginsNow) fprintf(f, "%s\t%.1f\t%d\n", m.first.c_str(), m.second.mean, m.second.low);
+    fclose(f);
+  }
+
+  if (update && timing) {
+    FILE *f = fopen((dir + "/baseline" + suffix + ".tsv").c_str(), "w");
+    if (!f) {
+      perror("baseline.tsv");
+      return 1;
+    }
+    for (auto &b : now) fprintf(f, "%s\t%.0f\t%.0f\n", b.first.c_str(), b.second.cpuUs, b.second.worstNs);
+    fclose(f);
+  }
+
+  if (!audio.empty()) front_end_speed(audio);
+  if (!latency.empty()) {
+    printf("display latency: median %.0f ms", median(latency));
+    if (!earlyLatency.empty()) printf(", %.0f ms with early commit", median(earlyLatency));
+    printf("\n");
+  }
+  printf("%zu fixtures, %d failed, %.1f%% copy%s\n", names.size(), failures, copySum * 100 / names.size(),
+         update ? " (golden files updated)" : "");
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,69 @@
+/****************************************
+  Dictionary reader tests.
+
+  Packs a dictionary the way tools/mkdict does, large enough that its
+  bit offsets no longer fit in 16 bits (past 10922 symbols), and checks
+  that every entry reads back through dict_copy() as it went in.
+
+  Usage: dictionary_test
+*****************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "Dictionary.h"
+
+static const char symbols[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789,./?";
+
+int main()
+{
+  // 3000 distinct entries of 1 to DICT_MAXLEN characters, about 27000 symbols
+  std::vector<std::string> words;
+  for (unsigned n = 0; n < 3000; n++) {
+    std::string w;
+    unsigned len = 1 + n % DICT_MAXLEN, v = n;
+    for (unsigned i = 0; i < len; i++) {
+      w += symbols[v % 40];
+      v = v / 40 + i * 7;
+    }
+    words.push_back(w);
+  }
+
+  // As mkdict's emit(): a length symbol, then the characters, six bits
+  // each, LSB first, with a pad byte
+  std::vector<int> sym;
+  std::vector<uint16_t> index;
+  for (size_t n = 0; n < words.size(); n++) {
+    if (n % DICT_STRIDE == 0) index.push_back(sym.size());
+    sym.push_back(words[n].size());
+    for (char c : words[n]) sym.push_back(strchr(symbols, c) - symbols + 1);
+  }
+  std::vector<byte> blob((sym.size() * 6 + 7) / 8 + 1, 0);
+  for (size_t k = 0; k < sym.size(); k++) {
+    size_t bit = k * 6;
+    unsigned v = unsigned(sym[k]) << (bit & 7);
+    blob[bit / 8] |= v & 0xFF;
+    blob[bit / 8 + 1] |= v >> 8;
+  }
+  std::vector<uint16_t> koch(41, words.size());
+  Dictionary d = {blob.data(), index.data(), koch.data(), (uint16_t)words.size()};
+
+  unsigned failures = 0, past = 0;
+  for (size_t n = 0; n < words.size(); n++) {
+    char buf[64];   // a bad length symbol can be up to 63
+    byte len = dict_copy(&d, n, buf);
+    if (dict_find(&d, n) > 65535 / 6) past++;
+    if (len > DICT_MAXLEN || words[n] != buf) {
+      if (failures < 10) printf("FAIL entry %zu: '%s' read as '%.*s'\n", n, words[n].c_str(),
+                                DICT_MAXLEN, buf);
+      failures++;
+    }
+  }
+  printf("%zu entries, %zu symbols, %u past symbol %u, %u failed\n",
+         words.size(), sym.size(), past, 65535 / 6, failures);
+  return (failures || !past) ? 1 : 0;
+}
@@ -0,0 +1,55 @@
+/****************************************
+  Morse code table tests.
+
+  morseDecode() and morseStarts() answer from tables built at compile
+  time. This checks both against a plain scan of morseCodes[] for
+  every code of up to one element more than MORSE_MAX_ELEMENTS, so the
+  codes too long for morseChars[] are covered as well as the table.
+
+  Usage: morse_code_test
+*****************************************/
+
+#include <stdio.h>
+
+#include "Arduino.h"
+#include "MorseCode.h"
+
+// The character with a code, from '_' down as the tables are built
+static char scan_decode(MorseCode code)
+{
+  if (code <= MORSE_EMPTY) return '*';
+  for (int c = MORSE_CHARS - 1; c > 0; c--) {
+    if (pgm_read_word_near(morseCodes + c) == code) return c;
+  }
+  return '*';
+}
+
+static bool scan_starts(MorseCode code)
+{
+  byte n = morseLength(code);
+  for (int c = 1; c < MORSE_CHARS; c++) {
+    MorseCode k = pgm_read_word_near(morseCodes + c);
+    byte m = morseLength(k);
+    if (m > n && (k >> (m - n)) == code) return true;
+  }
+  return false;
+}
+
+int main()
+{
+  unsigned codes = 0, chars = 0, prefixes = 0, failures = 0;
+  for (MorseCode code = 0; code < (4 << MORSE_MAX_ELEMENTS); code++) {
+    char want = scan_decode(code), got = morseDecode(code);
+    bool wantStarts = scan_starts(code), gotStarts = morseStarts(code);
+    codes++;
+    if (want != '*') chars++;
+    if (wantStarts) prefixes++;
+    if (got != want || gotStarts != wantStarts) {
+      printf("FAIL code 0x%03x (%u elements): decode '%c' want '%c', starts %d want %d\n",
+             code, morseLength(code), got, want, gotStarts, wantStarts);
+      failures++;
+    }
+  }
+  printf("%u codes, %u characters, %u prefixes, %u failed\n", codes, chars, prefixes, failures);
+  return failures ? 1 : 0;
+}
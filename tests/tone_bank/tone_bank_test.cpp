@@ -0,0 +1,140 @@
+/****************************************
+  ToneBank keying tests.
+
+  Each case renders one or more keyed tones through AudioEncoder and
+  ToneRenderer, as morse2wav does, runs the audio through a ToneBank
+  with the settings multidecode uses, and lists the channels that
+  keyed at any time. They must be exactly the channels of the stations
+  meant to be copied:
+    - a clean tone keys only its own channel, wherever it sits
+    - a spur 60 dB down, as a truncated sine table or a transmitter's
+      harmonic would make, keys nothing
+    - a second station 20 dB down is still copied, and the strong
+      one's first edge, which splatters over the band, keys nothing
+
+  Usage: tone_bank_test
+*****************************************/
+
+#include <math.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "ArduinoHal.h"
+#include "tone_bank.h"
+#include "tone_renderer.h"
+
+struct Tone {
+  double pitch;
+  double db;          // level, dB from half scale
+  bool copy;          // meant to key its channel
+};
+
+struct Case {
+  std::string name;
+  std::vector<Tone> tones;
+};
+
+// Every tone keys the same text at 20 wpm, from the same start
+static std::vector<int16_t> render(const std::vector<Tone> &tones)
+{
+  hal::reset();
+  hal::set_virtual_time(0, 0);
+  MorseSpeaker spkr(11);
+  std::vector<std::unique_ptr<ToneRenderer>> out;
+  std::vector<std::unique_ptr<AudioEncoder>> enc;
+  for (size_t i = 0; i < tones.size(); i++) {
+    ToneConfig tc;
+    tc.pitch = tones[i].pitch;
+    tc.level = 0.5 * pow(10, tones[i].db / 20);
+    out.emplace_back(new ToneRenderer(tc));
+    enc.emplace_back(new AudioEncoder(*out[i], 20 + i, &spkr));
+    enc[i]->setspeed(20);
+  }
+
+  const std::string text = "CQ DE N4TL";
+  delay(200);
+  std::vector<size_t> next(tones.size(), 0);
+  bool busy;
+  do {
+    busy = false;
+    for (size_t i = 0; i < tones.size(); i++) {
+      enc[i]->encode();
+      if (!enc[i]->available()) {
+        busy = true;
+      } else if (next[i] < text.size()) {
+        enc[i]->write(text[next[i]++]);
+        busy = true;
+      }
+    }
+  } while (busy);
+  delay(500);
+
+  std::vector<int16_t> pcm;
+  for (auto &t : out) {
+    t->renderTo(hal::now_us());
+    pcm.resize(t->samples().size(), 0);
+    for (size_t j = 0; j < pcm.size(); j++) pcm[j] += t->samples()[j];
+  }
+  return pcm;
+}
+
+// Frequencies of the channels that keyed
+static std::vector<double> keyed_channels(std::vector<int16_t> pcm)
+{
+  BankConfig bc;
+  ToneBank bank(bc);
+  std::vector<bool> keyed(bank.channels(), false);
+  size_t hop = bank.hop();
+  pcm.resize((pcm.size() + hop - 1) / hop * hop, 0);
+  for (size_t pos = 0; pos < pcm.size(); pos += hop) {
+    bank.update(&pcm[pos]);
+    for (size_t i = 0; i < bank.channels(); i++) {
+      if (bank.keyed(i)) keyed[i] = true;
+    }
+  }
+  std::vector<double> f;
+  for (size_t i = 0; i < bank.channels(); i++) {
+    if (keyed[i]) f.push_back(bank.frequency(i));
+  }
+  return f;
+}
+
+int main()
+{
+  std::vector<Case> cases;
+  for (double p : {500.0, 600.0, 700.0, 800.0, 1000.0, 1500.0, 2200.0}) {
+    char name[32];
+    snprintf(name, sizeof(name), "single_%.0f", p);
+    cases.push_back(Case{name, {{p, 0, true}}});
+  }
+  cases.push_back(Case{"spur_60dB", {{700, 0, true}, {2500, -60, false}}});
+  cases.push_back(Case{"harmonic_40dB", {{600, 0, true}, {1800, -40, false}}});
+  cases.push_back(Case{"second_20dB", {{500, 0, true}, {1100, -20, true}}});
+  cases.push_back(Case{"second_below_20dB", {{1100, 0, true}, {500, -20, true}}});
+
+  int failures = 0;
+  for (const Case &c : cases) {
+    std::vector<double> want;
+    for (const Tone &t : c.tones) {
+      if (t.copy) want.push_back(t.pitch);
+    }
+    std::sort(want.begin(), want.end());
+    std::vector<double> got = keyed_channels(render(c.tones));
+    std::string list;
+    for (double f : got) {
+      char buf[16];
+      snprintf(buf, sizeof(buf), " %.0f", f);
+      list += buf;
+    }
+    bool ok = got == want;
+    printf("%s %-18s keyed:%s\n", ok ? "ok  " : "FAIL", c.name.c_str(), list.empty() ? " none" : list.c_str());
+    if (!ok) failures++;
+  }
+  printf("%zu cases, %d failed\n", cases.size(), failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,415 @@
+/****************************************
+  batchdecode - copy a class's worth of recordings at once.
+
+  Every WAV file named, or found under a directory named, is decoded
+  by the trainer's own MorseDecoder, one file per task on a WorkPool
+  (native/work_pool.h). Each worker thread has its own HAL, so every
+  task makes its decoder on its own virtual clock and no decoder state
+  is shared. Files are memory mapped and the samples read in place.
+
+  A file goes through the vectorised audio front end (native/envelope.h)
+  and its key edges are replayed through MorseDecoder::edge(), which is
+  the same copy as feeding the decoder one sample at a time. Without
+  --wpm the speed is estimated from the marks found at 20 WPM and the
+  front end run again at that speed.
+
+  The report has one row per file in the order given, directories in
+  name order, written as soon as the files before it are done:
+    file, seconds of audio, sample rate, wpm, characters, mean and
+    lowest confidence, CPU ms, times real time, text, error
+  as CSV, or a JSON array of objects with those names with --json.
+  Prosigns are written <AR>, <BT>, <KN>, <SK> and <SOS>. The totals and
+  the wall clock speed go to stderr.
+
+  Usage: batchdecode [options] FILE.wav|DIR ...
+    --list FILE       also read paths from FILE, one a line ("-" stdin)
+    --wpm N           decoder speed (default: estimated per file)
+    --json            JSON instead of CSV
+    -o FILE           report to FILE (default stdout)
+    --threads N       worker threads (default one per core)
+*****************************************/
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "ArduinoHal.h"
+#include <MorseEnDecoder.h>
+#include "envelope.h"
+#include "work_pool.h"
+
+static const uint8_t key_pin = 2;           // the front end's edges key this, active low
+static const uint64_t start_us = 1000000;   // virtual time a file starts at
+static const int guess_wpm = 20;            // front end speed for the estimate
+
+struct Result {
+  double seconds = 0;
+  unsigned rate = 0;
+  int wpm = 0;
+  std::string text;
+  std::vector<int> confidence;   // per character, spaces left out
+  double cpuMs = 0;
+  std::string error;
+};
+
+// A read-only mapping of a whole file
+struct Mapped {
+  const uint8_t *data = NULL;
+  size_t size = 0;
+
+  bool open(const char *path)
+  {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0 && st.st_size > 0;
+    if (ok) {
+      void *p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      ok = p != MAP_FAILED;
+      if (ok) {
+        data = (const uint8_t *)p;
+        size = st.st_size;
+        madvise(p, size, MADV_SEQUENTIAL);
+      }
+    }
+    close(fd);
+    return ok;
+  }
+  ~Mapped()
+  {
+    if (data) munmap((void *)data, size);
+  }
+};
+
+static uint32_t le32(const uint8_t *p)
+{
+  return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+// 16 bit PCM, the first channel. Mono samples are used where they lie
+// in the mapping when the host is little endian and they are aligned,
+// anything else is copied into own.
+static bool parse_wav(const Mapped &m, AudioInput &in, unsigned &rate, std::vector<int16_t> &own)
+{
+  const uint8_t *d = m.data;
+  if (m.size < 12 || memcmp(d, "RIFF", 4) || memcmp(d + 8, "WAVE", 4)) return false;
+  unsigned channels = 0;
+  for (size_t i = 12; i + 8 <= m.size; ) {
+    uint32_t len = le32(d + i + 4);
+    if (!memcmp(d + i, "fmt ", 4) && len >= 16 && i + 8 + len <= m.size) {
+      if (d[i+8] != 1 || d[i+9] != 0 || d[i+22] != 16) return false;
+      channels = d[i+10] | d[i+11] << 8;
+      rate = le32(d + i + 12);
+    } else if (!memcmp(d + i, "data", 4) && channels) {
+      const uint8_t *pcm = d + i + 8;
+      size_t bytes = std::min<size_t>(len, m.size - i - 8);
+      in.samples = bytes / (2 * channels);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+      if (channels == 1 && ((uintptr_t)pcm & 1) == 0) {
+        in.pcm = (const int16_t *)pcm;
+        return rate > 0;
+      }
+#endif
+      own.resize(in.samples);
+      for (size_t k = 0; k < in.samples; k++) {
+        const uint8_t *s = pcm + 2 * channels * k;
+        own[k] = (int16_t)(s[0] | s[1] << 8);
+      }
+      in.pcm = own.data();
+      return rate > 0;
+    }
+    if (len > m.size) return false;
+    i += 8 + len + (len & 1);
+  }
+  return false;
+}
+
+// Split the marks into dots and dashes at the geometric mean of the
+// short and long ones, as multidecode does, with the tenth and ninetieth
+// percentiles standing in for the shortest and longest so a glitch or
+// a held key does not move the split. The dot is then taken from each
+// mark with the space after it inside a character, two dots after a
+// dot and four after a dash, since the front end's filter lag makes
+// marks long and spaces short by the same amount.
+static int estimate_wpm(const std::vector<AudioEdge> &edges, int wpm)
+{
+  std::vector<double> marks;
+  for (size_t i = 0; i + 1 < edges.size(); i++) {
+    if (edges[i].mark) marks.push_back(edges[i+1].start - edges[i].start);
+  }
+  if (marks.size() < 4) return wpm;
+  std::vector<double> sorted = marks;
+  std::sort(sorted.begin(), sorted.end());
+  double lo = sorted[sorted.size() / 10], hi = sorted[sorted.size() * 9 / 10];
+  double split = (hi > 2 * lo) ? sqrt(lo * hi) : 1200.0 / wpm * sqrt(3.0);
+  double dot = split / sqrt(3.0);
+  double sum = 0;
+  size_t n = 0;
+  for (size_t i = 0, m = 0; i + 2 < edges.size(); i++) {
+    if (!edges[i].mark) continue;
+    double mark = marks[m++];
+    double space = edges[i+2].start - edges[i+1].start;
+    if (space >= 2 * dot) continue;   // between characters
+    sum += (mark + space) / ((mark < split) ? 2 : 4);
+    n++;
+  }
+  if (n) dot = sum / n;
+  return std::max(5, std::min(60, (int)lround(1200 / dot)));
+}
+
+static double thread_cpu_ms()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static void decode_file(const std::string &path, int wpm, Result &r)
+{
+  double cpu0 = thread_cpu_ms();
+  Mapped m;
+  std::vector<int16_t> own;
+  AudioInput in = {NULL, 0, 0};
+  if (!m.open(path.c_str())) {
+    r.error = strerror(errno);
+    return;
+  }
+  if (!parse_wav(m, in, r.rate, own)) {
+    r.error = "not a 16 bit PCM WAV file";
+    return;
+  }
+  r.seconds = (double)in.samples / r.rate;
+
+  // 3 s of silence on the end flushes the decoder
+  size_t length = in.samples + 3 * r.rate;
+  in.wpm = wpm ? wpm : guess_wpm;
+  std::vector<AudioEdge> edges = audio_edges({in}, r.rate, start_us, length)[0];
+  if (!wpm) {
+    int est = estimate_wpm(edges, guess_wpm);
+    if (est != in.wpm) {
+      in.wpm = est;
+      edges = audio_edges({in}, r.rate, start_us, length)[0];
+    }
+  }
+  r.wpm = in.wpm;
+
+  hal::reset();
+  hal::set_virtual_time(start_us, 0);
+  MorseSpeaker spkr(11);
+  MorseDecoder dec(key_pin, MORSE_KEYER, MORSE_ACTIVE_LOW, &spkr);
+  dec.setspeed(r.wpm);
+  hal::set_input(key_pin, HIGH);
+  for (const AudioEdge &e : edges) hal::schedule(e.at, [&dec, e]() { dec.edge(e.mark, e.start); });
+  hal::set_end_time(start_us + length * 1000000 / r.rate);
+  try {
+    for (;;) {
+      dec.decode();
+      if (!dec.available()) continue;
+      char c = dec.read();
+      if (c != ' ') r.confidence.push_back(dec.confidence());
+      r.text += c;
+    }
+  } catch (const hal::SimulationEnd &) {
+  }
+  while (!r.text.empty() && r.text.back() == ' ') r.text.pop_back();
+  r.cpuMs = thread_cpu_ms() - cpu0;
+}
+
+// Prosigns spelt out, other control characters dropped
+static std::string printable(const std::string &text)
+{
+  static const char *const prosigns[] = {"<AR>", "<BT>", "<KN>", "<SK>", "<SOS>"};
+  std::string s;
+  for (char c : text) {
+    if (c >= MORSE_AR && c <= MORSE_SOS) s += prosigns[c - MORSE_AR];
+    else if ((unsigned char)c >= ' ') s += c;
+  }
+  return s;
+}
+
+static std::string csv_quote(const std::string &s)
+{
+  if (s.find_first_of(",\"\n") == std::string::npos) return s;
+  std::string q = "\"";
+  for (char c : s) {
+    if (c == '"') q += '"';
+    q += c;
+  }
+  return q + "\"";
+}
+
+static std::string json_quote(const std::string &s)
+{
+  std::string q = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      q += '\\';
+      q += c;
+    } else if ((unsigned char)c < ' ') {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04x", c);
+      q += buf;
+    } else {
+      q += c;
+    }
+  }
+  return q + "\"";
+}
+
+static void write_row(FILE *out, bool json, bool first, const std::string &path, const Result &r)
+{
+  double mean = 0;
+  int lowest = 0;
+  if (!r.confidence.empty()) {
+    for (int c : r.confidence) mean += c;
+    mean /= r.confidence.size();
+    lowest = *std::min_element(r.confidence.begin(), r.confidence.end());
+  }
+  double speed = r.cpuMs > 0 ? r.seconds * 1000 / r.cpuMs : 0;
+  std::string text = printable(r.text);
+  if (json) {
+    fprintf(out, "%s\n  {\"file\": %s, \"seconds\": %.3f, \"rate\": %u, \"wpm\": %d, \"chars\": %zu, "
+                 "\"confidence\": %.1f, \"lowest\": %d, \"cpu_ms\": %.2f, \"x_real_time\": %.0f, "
+                 "\"text\": %s, \"error\": %s}",
+            first ? "" : ",", json_quote(path).c_str(), r.seconds, r.rate, r.wpm, r.confidence.size(),
+            mean, lowest, r.cpuMs, speed, json_quote(text).c_str(), json_quote(r.error).c_str());
+  } else {
+    fprintf(out, "%s,%.3f,%u,%d,%zu,%.1f,%d,%.2f,%.0f,%s,%s\n",
+            csv_quote(path).c_str(), r.seconds, r.rate, r.wpm, r.confidence.size(), mean, lowest,
+            r.cpuMs, speed, csv_quote(text).c_str(), csv_quote(r.error).c_str());
+  }
+}
+
+static bool is_wav(const std::string &name)
+{
+  return name.size() > 4 && !strcasecmp(name.c_str() + name.size() - 4, ".wav");
+}
+
+// A file as it is, a directory's WAV files and subdirectories in name order
+static void add_path(const std::string &path, std::vector<std::string> &files)
+{
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0 || !S_ISDIR(st.st_mode)) {
+    files.push_back(path);   // a missing file gets an error row
+    return;
+  }
+  DIR *d = opendir(path.c_str());
+  if (!d) {
+    files.push_back(path);
+    return;
+  }
+  std::vector<std::string> names;
+  while (struct dirent *e = readdir(d)) {
+    if (e->d_name[0] != '.') names.push_back(e->d_name);
+  }
+  closedir(d);
+  std::sort(names.begin(), names.end());
+  for (const std::string &n : names) {
+    std::string p = path + "/" + n;
+    if (stat(p.c_str(), &st) == 0 && S_ISDIR(st.st_mode)) add_path(p, files);
+    else if (is_wav(n)) files.push_back(p);
+  }
+}
+
+static bool add_list(const char *list, std::vector<std::string> &files)
+{
+  FILE *f = strcmp(list, "-") ? fopen(list, "r") : stdin;
+  if (!f) {
+    perror(list);
+    return false;
+  }
+  char line[4096];
+  while (fgets(line, sizeof(line), f)) {
+    size_t n = strcspn(line, "\r\n");
+    line[n] = '\0';
+    if (n) add_path(line, files);
+  }
+  if (f != stdin) fclose(f);
+  return true;
+}
+
+static int usage(const char *prog)
+{
+  fprintf(stderr, "Usage: %s [--list FILE] [--wpm N] [--json] [-o FILE] [--threads N] FILE.wav|DIR ...\n", prog);
+  return 1;
+}
+
+int main(int argc, char **argv)
+{
+  std::vector<std::string> files;
+  const char *out_file = NULL;
+  int wpm = 0;
+  bool json = false;
+  unsigned threads = 0;
+
+  for (int i = 1; i < argc; i++) {
+    const char *a = argv[i];
+    const char *v = (i + 1 < argc) ? argv[i+1] : NULL;
+    if (!strcmp(a, "--json")) { json = true; continue; }
+    if (a[0] != '-') { add_path(a, files); continue; }
+    if (!v) return usage(argv[0]);
+    i++;
+    if (!strcmp(a, "--list")) { if (!add_list(v, files)) return 1; }
+    else if (!strcmp(a, "--wpm")) wpm = atoi(v);
+    else if (!strcmp(a, "-o")) out_file = v;
+    else if (!strcmp(a, "--threads")) threads = atoi(v);
+    else return usage(argv[0]);
+  }
+  if (files.empty() || wpm < 0) return usage(argv[0]);
+
+  FILE *out = out_file ? fopen(out_file, "w") : stdout;
+  if (!out) {
+    perror(out_file);
+    return 1;
+  }
+  if (json) fputs("[", out);
+  else fputs("file,seconds,rate,wpm,chars,confidence,lowest,cpu_ms,x_real_time,text,error\n", out);
+
+  // Rows go out in order as soon as every file before them is done
+  std::vector<Result> results(files.size());
+  std::vector<bool> done(files.size(), false);
+  std::mutex lock;
+  size_t next = 0;
+  auto wall = std::chrono::steady_clock::now();
+
+  WorkPool pool(threads);
+  pool.run(files.size(), [&](size_t task, unsigned) {
+    decode_file(files[task], wpm, results[task]);
+    std::lock_guard<std::mutex> hold(lock);
+    done[task] = true;
+    for (; next < files.size() && done[next]; next++) {
+      write_row(out, json, next == 0, files[next], results[next]);
+    }
+  });
+  if (json) fputs("\n]\n", out);
+  bool failed = (out != stdout) ? fclose(out) != 0 : fflush(out) != 0;
+
+  double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall).count();
+  double audio_s = 0, cpu_ms = 0;
+  size_t errors = 0;
+  for (const Result &r : results) {
+    audio_s += r.seconds;
+    cpu_ms += r.cpuMs;
+    if (!r.error.empty()) errors++;
+  }
+  fprintf(stderr, "%zu files (%zu unreadable), %.1f s of audio on %u threads in %.2f s: "
+                  "%.0fx real time, %.0fx per core\n",
+          files.size(), errors, audio_s, pool.threads(), wall_s,
+          wall_s > 0 ? audio_s / wall_s : 0, cpu_ms > 0 ? audio_s * 1000 / cpu_ms : 0);
+  return (failed || errors) ? 1 : 0;
+}
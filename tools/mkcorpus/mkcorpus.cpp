@@ -0,0 +1,340 @@
+/****************************************
+  mkcorpus - labelled Morse corpus generator.
+
+  Builds text, keyed edge timings and optionally audio for every cell
+  of a grid of speeds, fists and noise levels. The element patterns
+  come from the encoder's code table (MorseCode.h), the fist model
+  then stretches and jitters them, and ToneRenderer turns them into
+  shaped audio with white noise added at the given SNR.
+
+  Work is split into chunks of samples spread over all cores with a
+  work-stealing pool. Each chunk is written as soon as it is done:
+    OUT/chunk_NNNNN.tsv   one sample per line:
+                          id, wpm, fist, snr, text, edges, audio offset, audio samples
+                          edges are mark,space,mark,... durations in ms
+    OUT/chunk_NNNNN.raw   16 bit little endian mono PCM (with --audio)
+    OUT/manifest.tsv      chunk, samples, wpm, fist, snr
+
+  Usage: mkcorpus --out DIR [options]
+    --samples N       samples per grid cell (default 1000)
+    --chunk N         samples per chunk file (default 500)
+    --wpm LIST        speeds, e.g. 15,20,25 (default 15,20,25,30)
+    --fist LIST       from ideal,heavy,light,farnsworth,sloppy,bug (default all)
+    --snr LIST        dB, or "clean" (default clean; needs --audio)
+    --groups N        groups of five characters per sample (default 4)
+    --chars STRING    characters to draw from (default A-Z 0-9 . , / ? =)
+    --audio           render audio
+    --rate HZ         sample rate (default 8000)
+    --pitch HZ        tone (default 700)
+    --threads N       worker threads (default one per core)
+    --seed N          (default 1)
+*****************************************/
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "ArduinoHal.h"
+#include "MorseCode.h"
+#include "tone_renderer.h"
+#include "work_pool.h"
+
+// Timing of a fist, in dots at the nominal speed
+struct Fist {
+  const char *name;
+  double dash;        // dash length
+  double charGap;     // space between characters
+  double wordGap;     // space between groups
+  double weight;      // added to every mark and taken from the space after it
+  double jitter;      // standard deviation of every element, fraction of its length
+  bool bug;           // dashes keyed by hand anywhere from 2.5 to 4.5 dots
+};
+
+static const Fist fists[] = {
+  {"ideal",      3.0, 3, 7,  0.0, 0.00, false},
+  {"heavy",      3.3, 3, 7,  0.3, 0.05, false},
+  {"light",      3.0, 3, 7, -0.3, 0.05, false},
+  {"farnsworth", 3.0, 6, 14, 0.0, 0.03, false},
+  {"sloppy",     3.0, 3, 7,  0.0, 0.20, false},
+  {"bug",        3.0, 3, 7,  0.0, 0.10, true},
+};
+
+struct Cell {
+  int wpm;
+  const Fist *fist;
+  double snr;         // NAN = clean
+};
+
+struct Options {
+  const char *out = NULL;
+  size_t samples = 1000;
+  size_t chunk = 500;
+  int groups = 4;
+  std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789.,/?=";
+  bool audio = false;
+  ToneConfig tone;
+  unsigned threads = 0;
+  unsigned long seed = 1;
+};
+
+static std::string codes[MORSE_CHARS];   // dots and dashes for each character
+
+
+// Spell out the code of every character the encoder knows
+static void load_codes()
+{
+  for (int c = 1; c < MORSE_CHARS; c++) {
+    MorseCode code = morseEncode(c);
+    for (int i = morseLength(code) - 1; i >= 0; i--) codes[c] += ((code >> i) & 1) ? '-' : '.';
+  }
+}
+
+static std::vector<std::string> split(const char *list)
+{
+  std::vector<std::string> v;
+  std::string s;
+  for (const char *p = list; ; p++) {
+    if (*p == ',' || *p == '\0') {
+      if (!s.empty()) v.push_back(s);
+      s.clear();
+      if (!*p) break;
+    } else {
+      s += *p;
+    }
+  }
+  return v;
+}
+
+// One sample: random groups, keyed by the fist at the cell's speed
+static void make_sample(const Options &opt, const Cell &cell, std::mt19937_64 &rng,
+                        std::string &text, std::vector<double> &edges)
+{
+  std::uniform_int_distribution<size_t> pick(0, opt.chars.size() - 1);
+  std::normal_distribution<double> jit(0, cell.fist->jitter);
+  std::uniform_real_distribution<double> bugDash(2.5, 4.5);
+  const Fist &f = *cell.fist;
+  double dot = 1200.0 / cell.wpm;
+
+  text.clear();
+  edges.clear();
+  for (int g = 0; g < opt.groups; g++) {
+    if (g) text += ' ';
+    for (int i = 0; i < 5; i++) text += opt.chars[pick(rng)];
+  }
+
+  for (size_t i = 0; i < text.size(); i++) {
+    if (text[i] == ' ') continue;
+    const std::string &code = codes[(int)text[i]];
+    for (size_t j = 0; j < code.size(); j++) {
+      double mark = (code[j] == '.') ? 1 : (f.bug ? bugDash(rng) : f.dash);
+      double space = 1;
+      if (j + 1 == code.size()) {
+        if (i + 1 == text.size()) space = 0;
+        else space = (text[i+1] == ' ') ? f.wordGap : f.charGap;
+      }
+      mark = (mark + f.weight) * (1 + ((f.bug && code[j] == '.') ? 0 : jit(rng)));
+      if (space > 0) space = (space - f.weight) * (1 + jit(rng));
+      edges.push_back(dot * std::max(mark, 0.2));
+      if (space > 0) edges.push_back(dot * std::max(space, 0.2));
+    }
+  }
+}
+
+// Render the edges, 100 ms of lead in and 300 ms of tail, plus noise
+static void render(const Options &opt, const Cell &cell, std::mt19937_64 &rng,
+                   const std::vector<double> &edges, std::vector<int16_t> &pcm)
+{
+  ToneRenderer tone(opt.tone);
+  double t = 100;
+  for (size_t i = 0; i < edges.size(); i++) {
+    tone.key(i % 2 == 0, (uint64_t)(t * 1000));
+    t += edges[i];
+  }
+  tone.key(false, (uint64_t)(t * 1000));
+  tone.renderTo((uint64_t)((t + 300) * 1000));
+  pcm.swap(tone.samples());
+
+  if (!isnan(cell.snr)) {
+    double amp = 32767 * opt.tone.level;
+    std::normal_distribution<double> noise(0, amp / sqrt(2) / pow(10, cell.snr / 20));
+    for (int16_t &s : pcm) {
+      double v = s + noise(rng);
+      s = (int16_t)std::max(-32768.0, std::min(32767.0, round(v)));
+    }
+  }
+}
+
+static bool write_chunk(const Options &opt, size_t chunk, const Cell &cell, size_t first, size_t n)
+{
+  char name[512];
+  std::mt19937_64 rng(opt.seed * 1000003 + chunk);
+  std::string text;
+  std::vector<double> edges;
+  std::vector<int16_t> pcm;
+  long offset = 0;
+
+  snprintf(name, sizeof(name), "%s/chunk_%05zu.tsv", opt.out, chunk);
+  FILE *tsv = fopen(name, "w");
+  FILE *raw = NULL;
+  if (tsv && opt.audio) {
+    snprintf(name, sizeof(name), "%s/chunk_%05zu.raw", opt.out, chunk);
+    raw = fopen(name, "wb");
+  }
+  if (!tsv || (opt.audio && !raw)) {
+    perror(name);
+    if (tsv) fclose(tsv);
+    return false;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    make_sample(opt, cell, rng, text, edges);
+    fprintf(tsv, "%zu\t%d\t%s\t", first + i, cell.wpm, cell.fist->name);
+    if (isnan(cell.snr)) fputs("clean", tsv); else fprintf(tsv, "%g", cell.snr);
+    fprintf(tsv, "\t%s\t", text.c_str());
+    for (size_t e = 0; e < edges.size(); e++) fprintf(tsv, e ? ",%.1f" : "%.1f", edges[e]);
+    if (raw) {
+      render(opt, cell, rng, edges, pcm);
+      fwrite(pcm.data(), 2, pcm.size(), raw);
+      fprintf(tsv, "\t%ld\t%zu\n", offset, pcm.size());
+      offset += pcm.size();
+    } else {
+      fputs("\t\t\n", tsv);
+    }
+  }
+
+  bool ok = !ferror(tsv);
+  ok = (fclose(tsv) == 0) && ok;
+  if (raw) {
+    ok = !ferror(raw) && ok;
+    ok = (fclose(raw) == 0) && ok;
+  }
+  return ok;
+}
+
+static int usage(const char *prog)
+{
+  fprintf(stderr, "Usage: %s --out DIR [--samples N] [--chunk N] [--wpm LIST] [--fist LIST] [--snr LIST]\n"
+                  "       [--groups N] [--chars STRING] [--audio] [--rate HZ] [--pitch HZ] [--threads N] [--seed N]\n", prog);
+  return 1;
+}
+
+int main(int argc, char **argv)
+{
+  Options opt;
+  const char *wpmList = "15,20,25,30";
+  const char *fistList = NULL;
+  const char *snrList = "clean";
+
+  for (int i = 1; i < argc; i++) {
+    const char *a = argv[i];
+    const char *v = (i + 1 < argc) ? argv[i+1] : NULL;
+    if (!strcmp(a, "--audio")) { opt.audio = true; continue; }
+    if (!v) return usage(argv[0]);
+    i++;
+    if (!strcmp(a, "--out")) opt.out = v;
+    else if (!strcmp(a, "--samples")) opt.samples = strtoul(v, NULL, 0);
+    else if (!strcmp(a, "--chunk")) opt.chunk = strtoul(v, NULL, 0);
+    else if (!strcmp(a, "--wpm")) wpmList = v;
+    else if (!strcmp(a, "--fist")) fistList = v;
+    else if (!strcmp(a, "--snr")) snrList = v;
+    else if (!strcmp(a, "--groups")) opt.groups = atoi(v);
+    else if (!strcmp(a, "--chars")) opt.chars = v;
+    else if (!strcmp(a, "--rate")) opt.tone.rate = atoi(v);
+    else if (!strcmp(a, "--pitch")) opt.tone.pitch = atof(v);
+    else if (!strcmp(a, "--threads")) opt.threads = atoi(v);
+    else if (!strcmp(a, "--seed")) opt.seed = strtoul(v, NULL, 0);
+    else return usage(argv[0]);
+  }
+  if (!opt.out || opt.samples == 0 || opt.chunk == 0 || opt.groups <= 0) return usage(argv[0]);
+
+  load_codes();
+  for (char &c : opt.chars) {
+    if (c >= 'a' && c <= 'z') c -= 32;
+    if (c < 0 || c >= MORSE_CHARS || codes[(int)c].empty()) {
+      fprintf(stderr, "%s: no Morse code for '%c'\n", argv[0], c);
+      return 1;
+    }
+  }
+
+  // The grid
+  std::vector<Cell> cells;
+  std::vector<const Fist *> fistSel;
+  if (fistList) {
+    for (const std::string &name : split(fistList)) {
+      const Fist *f = NULL;
+      for (const Fist &x : fists) if (name == x.name) f = &x;
+      if (!f) {
+        fprintf(stderr, "%s: unknown fist %s\n", argv[0], name.c_str());
+        return 1;
+      }
+      fistSel.push_back(f);
+    }
+  } else {
+    for (const Fist &x : fists) fistSel.push_back(&x);
+  }
+  for (const std::string &w : split(wpmList)) {
+    for (const Fist *f : fistSel) {
+      for (const std::string &s : split(snrList)) {
+        if (s != "clean" && !opt.audio) continue;
+        int wpm = atoi(w.c_str());
+        if (wpm <= 0) return usage(argv[0]);
+        cells.push_back(Cell{wpm, f, s == "clean" ? NAN : atof(s.c_str())});
+      }
+    }
+  }
+  if (cells.empty()) {
+    fprintf(stderr, "%s: empty grid (noise levels need --audio)\n", argv[0]);
+    return 1;
+  }
+
+  if (mkdir(opt.out, 0777) != 0 && errno != EEXIST) {
+    perror(opt.out);
+    return 1;
+  }
+
+  size_t perCell = (opt.samples + opt.chunk - 1) / opt.chunk;
+  size_t chunks = cells.size() * perCell;
+  std::atomic<bool> failed(false);
+  auto wall = std::chrono::steady_clock::now();
+
+  WorkPool pool(opt.threads);
+  pool.run(chunks, [&](size_t chunk, unsigned) {
+    hal::set_virtual_time(0, 0);   // this worker's HAL
+    const Cell &cell = cells[chunk / perCell];
+    size_t first = (chunk % perCell) * opt.chunk;
+    size_t n = std::min(opt.chunk, opt.samples - first);
+    if (!write_chunk(opt, chunk, cell, (chunk / perCell) * opt.samples + first, n)) failed = true;
+  });
+
+  char name[512];
+  snprintf(name, sizeof(name), "%s/manifest.tsv", opt.out);
+  FILE *m = fopen(name, "w");
+  if (!m) {
+    perror(name);
+    return 1;
+  }
+  for (size_t chunk = 0; chunk < chunks; chunk++) {
+    const Cell &cell = cells[chunk / perCell];
+    size_t first = (chunk % perCell) * opt.chunk;
+    fprintf(m, "chunk_%05zu\t%zu\t%d\t%s\t", chunk, std::min(opt.chunk, opt.samples - first),
+            cell.wpm, cell.fist->name);
+    if (isnan(cell.snr)) fputs("clean\n", m); else fprintf(m, "%g\n", cell.snr);
+  }
+  if (fclose(m) != 0) failed = true;
+
+  double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall).count();
+  fprintf(stderr, "%zu samples in %zu chunks on %u threads, %.2f s\n",
+          cells.size() * opt.samples, chunks, pool.threads(), wall_s);
+  return failed ? 1 : 0;
+}
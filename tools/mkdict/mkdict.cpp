@@ -0,0 +1,162 @@
+/****************************************
+  mkdict - build the packed PROGMEM dictionaries for the CW Trainer.
+
+  Usage: mkdict name=wordlist.txt [name=wordlist.txt ...] > DictData.h
+
+  The trainer build uses:
+    mkdict dict_words=words.txt dict_calls=calls.txt dict_names=names.txt dict_qths=qths.txt > ../../cw-trainer/DictData.h
+
+  Each word list is plain text, one entry per line. Lines starting with
+  '#' are comments. Entries are upper cased, must only use the trainer's
+  40 characters and be 1 to 15 characters long; anything else is
+  reported and skipped.
+
+  Every entry is stored as a length symbol followed by its characters,
+  six bits per symbol. Entries are sorted by the Koch number they need
+  (the Koch position of their latest character), so the entries usable
+  at a given Koch number are always a prefix of the table. Output per
+  dictionary is:
+    <name>_blob[]   packed symbols
+    <name>_index[]  symbol offset of every DICT_STRIDE'th entry
+    <name>_koch[]   entries usable with Koch number 0..40
+    <name>          Dictionary descriptor for Dictionary.h
+
+  Build: g++ -O2 -o mkdict mkdict.cpp
+*****************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+// Must match Dictionary.h and koch[] in cw-trainer.ino
+static const int DICT_STRIDE = 16;
+static const int DICT_MAXLEN = 15;
+static const char symbols[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789,./?";
+static const char koch[] = "KMRSUAPTLOWI.NJEF0YV,G5/Q9ZH38B?427C1D6X";
+
+struct Entry {
+  std::string text;
+  int rank;  // Koch number needed to send every character
+};
+
+static int symbol_of(char c)
+{
+  const char *p = strchr(symbols, c);
+  return (c && p) ? int(p - symbols) + 1 : 0;
+}
+
+static int koch_rank(const std::string &w)
+{
+  int rank = 0;
+  for (char c : w) rank = std::max(rank, int(strchr(koch, c) - koch) + 1);
+  return rank;
+}
+
+static bool load(const char *path, std::vector<Entry> &out)
+{
+  std::ifstream in(path);
+  if (!in) {
+    std::cerr << "mkdict: cannot open " << path << "\n";
+    return false;
+  }
+
+  std::set<std::string> seen;
+  std::string line;
+  int lineno = 0;
+  while (std::getline(in, line)) {
+    ++lineno;
+    std::string w;
+    for (char c : line) {
+      if (c == '#') break;
+      if (c == ' ' || c == '\t' || c == '\r') continue;
+      w += (c >= 'a' && c <= 'z') ? char(c - 32) : c;
+    }
+    if (w.empty()) continue;
+
+    bool ok = w.size() <= size_t(DICT_MAXLEN);
+    for (char c : w) ok = ok && symbol_of(c);
+    if (!ok) {
+      std::cerr << path << ":" << lineno << ": skipping '" << w << "'\n";
+      continue;
+    }
+    if (seen.insert(w).second) out.push_back({w, koch_rank(w)});
+  }
+
+  std::stable_sort(out.begin(), out.end(),
+                   [](const Entry &a, const Entry &b) { return a.rank < b.rank; });
+  return true;
+}
+
+static void emit(const std::string &name, const std::vector<Entry> &words)
+{
+  std::vector<int> sym;
+  std::vector<unsigned> index;
+  for (size_t n = 0; n < words.size(); n++) {
+    if (n % DICT_STRIDE == 0) index.push_back(sym.size());
+    sym.push_back(words[n].text.size());
+    for (char c : words[n].text) sym.push_back(symbol_of(c));
+  }
+  if (sym.size() > 65535) {
+    std::cerr << "mkdict: " << name << " is too large for 16 bit offsets\n";
+    exit(1);
+  }
+
+  // Pack six bits per symbol, LSB first, plus a pad byte so the reader
+  // can always fetch two bytes.
+  std::vector<unsigned char> blob((sym.size() * 6 + 7) / 8 + 1, 0);
+  for (size_t k = 0; k < sym.size(); k++) {
+    size_t bit = k * 6;
+    unsigned v = unsigned(sym[k]) << (bit & 7);
+    blob[bit / 8] |= v & 0xFF;
+    blob[bit / 8 + 1] |= v >> 8;
+  }
+
+  printf("// %s: %zu entries, %zu symbols\n", name.c_str(), words.size(), sym.size());
+  printf("const byte %s_blob[] PROGMEM = {", name.c_str());
+  for (size_t i = 0; i < blob.size(); i++)
+    printf("%s0x%02X,", (i % 16) ? " " : "\n  ", blob[i]);
+  printf("\n};\n");
+
+  printf("const uint16_t %s_index[] PROGMEM = {", name.c_str());
+  for (size_t i = 0; i < index.size(); i++)
+    printf("%s%u,", (i % 10) ? " " : "\n  ", index[i]);
+  printf("\n};\n");
+
+  printf("const uint16_t %s_koch[] PROGMEM = {", name.c_str());
+  size_t n = 0;
+  for (int k = 0; k <= 40; k++) {
+    while (n < words.size() && words[n].rank <= k) n++;
+    printf("%s%zu,", (k % 10) ? " " : "\n  ", n);
+  }
+  printf("\n};\n");
+
+  printf("const Dictionary %s PROGMEM = {%s_blob, %s_index, %s_koch, %zu};\n\n",
+         name.c_str(), name.c_str(), name.c_str(), name.c_str(), words.size());
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 2) {
+    std::cerr << "Usage: mkdict name=wordlist.txt [name=wordlist.txt ...] > DictData.h\n";
+    return 1;
+  }
+
+  printf("// Generated by tools/mkdict from the word lists in tools/mkdict. Do not edit.\n");
+  printf("// Included once, by Dictionary.cpp.\n\n");
+  for (int a = 1; a < argc; a++) {
+    const char *eq = strchr(argv[a], '=');
+    if (!eq) {
+      std::cerr << "mkdict: expected name=file, got " << argv[a] << "\n";
+      return 1;
+    }
+    std::vector<Entry> words;
+    if (!load(eq + 1, words)) return 1;
+    emit(std::string(argv[a], eq - argv[a]), words);
+  }
+  return 0;
+}
@@ -0,0 +1,148 @@
+/****************************************
+  morse2wav - render text as CW audio.
+
+  Sends the text through MorseEncoder on the native HAL's virtual
+  clock and writes the keyed tone, with raised cosine edges, to a WAV
+  file. The timing is the trainer's own. With --station the file is a
+  pileup instead: every station keys its own text at its own pitch and
+  speed, all starting together, mixed at equal levels.
+
+  Usage: morse2wav [options] [text ...]   (text from stdin if none given)
+    -o FILE      output file (default morse.wav, - for stdout)
+    --wpm N      speed (default 20)
+    --pitch HZ   tone (default 700)
+    --rate HZ    sample rate (default 8000)
+    --rise MS    edge time (default 5)
+    --station PITCH:WPM:TEXT   add a station to a pileup, repeatable
+*****************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "ArduinoHal.h"
+#include "tone_renderer.h"
+
+struct Station {
+  double pitch;
+  int wpm;
+  std::string text;
+};
+
+int main(int argc, char **argv)
+{
+  const char *out_file = "morse.wav";
+  int wpm = 20;
+  ToneConfig tc;
+  std::string text;
+  std::vector<Station> stations;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+      out_file = argv[++i];
+    } else if (!strcmp(argv[i], "--wpm") && i + 1 < argc) {
+      wpm = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--pitch") && i + 1 < argc) {
+      tc.pitch = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--rate") && i + 1 < argc) {
+      tc.rate = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--rise") && i + 1 < argc) {
+      tc.riseMs = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--station") && i + 1 < argc) {
+      Station st;
+      int used = 0;
+      if (sscanf(argv[++i], "%lf:%d:%n", &st.pitch, &st.wpm, &used) != 2 || !used) {
+        fprintf(stderr, "%s: --station wants PITCH:WPM:TEXT\n", argv[0]);
+        return 1;
+      }
+      st.text = argv[i] + used;
+      stations.push_back(st);
+    } else if (argv[i][0] == '-' && argv[i][1]) {
+      fprintf(stderr, "Usage: %s [-o FILE] [--wpm N] [--pitch HZ] [--rate HZ] [--rise MS]\n"
+                      "       [--station PITCH:WPM:TEXT ...] [text ...]\n", argv[0]);
+      return 1;
+    } else {
+      if (!text.empty()) text += ' ';
+      text += argv[i];
+    }
+  }
+  if (stations.empty()) {
+    if (text.empty()) {
+      int c;
+      while ((c = getchar()) != EOF) text += (c == '\n' || c == '\r') ? ' ' : (char)c;
+    }
+    stations.push_back({tc.pitch, wpm, text});
+  } else if (!text.empty()) {
+    fprintf(stderr, "%s: text goes in --station when there are stations\n", argv[0]);
+    return 1;
+  }
+  for (const Station &st : stations) {
+    if (tc.rate < 1000 || st.pitch <= 0 || st.pitch >= tc.rate / 2 || st.wpm <= 0) {
+      fprintf(stderr, "%s: bad speed, pitch or rate\n", argv[0]);
+      return 1;
+    }
+  }
+
+  auto wall = std::chrono::steady_clock::now();
+  hal::set_virtual_time(0, 0);
+  MorseSpeaker spkr(11);
+  std::vector<std::unique_ptr<ToneRenderer>> tones;
+  std::vector<std::unique_ptr<AudioEncoder>> encoders;
+  for (size_t i = 0; i < stations.size(); i++) {
+    ToneConfig stc = tc;
+    stc.pitch = stations[i].pitch;
+    stc.level = tc.level / stations.size();
+    tones.emplace_back(new ToneRenderer(stc));
+    encoders.emplace_back(new AudioEncoder(*tones[i], 20 + i, &spkr));
+    encoders[i]->setspeed(stations[i].wpm);
+  }
+
+  // Feed every encoder its next character as soon as it goes idle
+  delay(200);  // lead in
+  std::vector<size_t> next(stations.size(), 0);
+  bool busy;
+  do {
+    busy = false;
+    for (size_t i = 0; i < stations.size(); i++) {
+      encoders[i]->encode();
+      if (!encoders[i]->available()) {
+        busy = true;
+      } else if (next[i] < stations[i].text.size()) {
+        encoders[i]->write(stations[i].text[next[i]++]);
+        busy = true;
+      }
+    }
+  } while (busy);
+  delay(500);  // let the last element die away
+
+  // Mix, each station already at its share of the level
+  ToneRenderer &tone = *tones[0];
+  for (auto &t : tones) t->renderTo(hal::now_us());
+  for (size_t i = 1; i < tones.size(); i++) {
+    for (size_t j = 0; j < tone.samples().size(); j++) tone.samples()[j] += tones[i]->samples()[j];
+  }
+
+  FILE *f = strcmp(out_file, "-") ? fopen(out_file, "wb") : stdout;
+  if (!f) {
+    perror(out_file);
+    return 1;
+  }
+  bool ok = write_wav(f, tone.samples().data(), tone.samples().size(), tc.rate);
+  if (f != stdout) ok = (fclose(f) == 0) && ok;
+  if (!ok) {
+    perror(out_file);
+    return 1;
+  }
+
+  double audio_s = (double)tone.samples().size() / tc.rate;
+  double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall).count();
+  fprintf(stderr, "%.1f s of audio in %.3f s (%.0fx real time)\n",
+          audio_s, wall_s, wall_s > 0 ? audio_s / wall_s : 0.0);
+  return 0;
+}
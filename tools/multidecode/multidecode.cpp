@@ -0,0 +1,184 @@
+/****************************************
+  multidecode - copy every CW signal in a recording at once.
+
+  A ToneBank (native/tone_bank.h) spreads tone detectors across the
+  passband. Each channel that keys gets its own MorseDecoder, fed
+  through a spare input pin on the HAL's virtual clock, so every
+  signal is copied by the trainer's own decoder. A channel's speed is
+  estimated from its mark lengths and passed on with setspeed().
+
+  At the end every channel that copied anything is listed with its
+  frequency, speed, signal to noise ratio and text; --stream also
+  prints each character as it is decoded. The time taken against the
+  length of the audio is reported on stderr.
+
+  Usage: multidecode [options] [FILE.wav]   (stdin if no file)
+    --low HZ       lowest channel (default 300)
+    --high HZ      highest channel (default 2700)
+    --spacing HZ   channel spacing (default 100)
+    --snr DB       key down this far over the noise floor (default 12)
+    --range DB     and no further below the strongest signal (default 35)
+    --wpm N        starting speed guess for every channel (default 20)
+    --stream       print "time frequency character" as characters arrive
+
+  A pileup to try it on:
+    morse2wav -o pileup.wav --station 500:18:"CQ TEST N4TL" \
+      --station 800:25:"KC1DMR KC1DMR" --station 1100:30:"W1AW 5NN CT"
+*****************************************/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+#include "ArduinoHal.h"
+#include "tone_bank.h"
+#include "tone_renderer.h"
+
+static const uint8_t first_pin = 12;   // channel i keys pin first_pin + i, above the speaker
+
+struct Channel {
+  std::unique_ptr<MorseDecoder> dec;   // made when the channel first keys
+  bool keyed = false;
+  uint64_t edge = 0;                   // last key change, us
+  std::deque<double> marks;            // recent mark lengths, ms
+  int wpm = 0;
+  std::string text;
+};
+
+// Split the recent marks into dots and dashes at the geometric mean
+// of the shortest and longest, once there is a clear gap between them,
+// and take the dot length from both. Until then marks are taken as
+// whichever of a dot or dash at the current speed they are nearer.
+static int estimate_wpm(const std::deque<double> &marks, int wpm)
+{
+  double lo = *std::min_element(marks.begin(), marks.end());
+  double hi = *std::max_element(marks.begin(), marks.end());
+  double split = (hi > 2 * lo) ? sqrt(lo * hi) : 1200.0 / wpm * sqrt(3.0);
+  double sum = 0;
+  for (double m : marks) sum += (m < split) ? m : m / 3;
+  double dot = sum / marks.size();
+  return std::max(5, std::min(60, (int)lround(1200 / dot)));
+}
+
+int main(int argc, char **argv)
+{
+  const char *in_file = NULL;
+  BankConfig bc;
+  int wpm = 20;
+  bool stream = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--low") && i + 1 < argc) {
+      bc.low = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--high") && i + 1 < argc) {
+      bc.high = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--spacing") && i + 1 < argc) {
+      bc.spacing = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--snr") && i + 1 < argc) {
+      bc.snrDb = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--range") && i + 1 < argc) {
+      bc.rangeDb = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "--wpm") && i + 1 < argc) {
+      wpm = atoi(argv[++i]);
+    } else if (!strcmp(argv[i], "--stream")) {
+      stream = true;
+    } else if (argv[i][0] != '-' && !in_file) {
+      in_file = argv[i];
+    } else {
+      fprintf(stderr, "Usage: %s [--low HZ] [--high HZ] [--spacing HZ] [--snr DB] [--range DB] [--wpm N] [--stream] [FILE.wav]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  FILE *f = in_file ? fopen(in_file, "rb") : stdin;
+  if (!f) {
+    perror(in_file);
+    return 1;
+  }
+  std::vector<int16_t> pcm;
+  bool ok = read_wav(f, pcm, bc.rate);
+  if (f != stdin) fclose(f);
+  if (!ok) {
+    fprintf(stderr, "%s: not a 16 bit PCM WAV file\n", in_file ? in_file : "stdin");
+    return 1;
+  }
+  if (bc.spacing <= 0 || bc.low <= 0 || bc.high < bc.low || wpm <= 0) {
+    fprintf(stderr, "%s: bad channel range or speed\n", argv[0]);
+    return 1;
+  }
+
+  auto wall = std::chrono::steady_clock::now();
+  hal::set_virtual_time(0, 0);
+  ToneBank bank(bc);
+  if (bank.channels() == 0 || first_pin + bank.channels() > NUM_DIGITAL_PINS) {
+    fprintf(stderr, "%s: %zu channels, the HAL has pins for 1 to %d\n", argv[0],
+            bank.channels(), NUM_DIGITAL_PINS - first_pin);
+    return 1;
+  }
+  MorseSpeaker spkr(11);   // shared, sidetone stays off
+  std::vector<Channel> chans(bank.channels());
+
+  size_t hop = bank.hop();
+  size_t audio = pcm.size();
+  pcm.resize((audio + 3 * bc.rate + hop - 1) / hop * hop, 0);   // 3 s of silence flushes the decoders
+  for (size_t pos = 0; pos < pcm.size(); pos += hop) {
+    bank.update(&pcm[pos]);
+    uint64_t t = (uint64_t)(pos + hop) * 1000000 / bc.rate;
+    delayMicroseconds(t - hal::now_us());
+
+    for (size_t i = 0; i < chans.size(); i++) {
+      Channel &ch = chans[i];
+      uint8_t pin = first_pin + i;
+      if (bank.keyed(i) != ch.keyed) {
+        if (!ch.dec) {
+          hal::set_input(pin, HIGH);
+          ch.dec.reset(new MorseDecoder(pin, MORSE_KEYER, MORSE_ACTIVE_LOW, &spkr));
+          ch.wpm = wpm;
+          ch.dec->setspeed(wpm);
+        }
+        ch.keyed = !ch.keyed;
+        hal::set_input(pin, !ch.keyed);   // marks pull the input low
+        if (!ch.keyed) {
+          ch.marks.push_back((t - ch.edge) / 1000.0);
+          if (ch.marks.size() > 12) ch.marks.pop_front();
+          int est = estimate_wpm(ch.marks, ch.wpm);
+          if (est != ch.wpm) {
+            ch.wpm = est;
+            ch.dec->setspeed(est);
+          }
+        }
+        ch.edge = t;
+      }
+      if (!ch.dec) continue;
+      ch.dec->decode();
+      if (ch.dec->available()) {
+        char c = ch.dec->read();
+        if (c == ' ' && (ch.text.empty() || ch.text.back() == ' ')) continue;
+        ch.text += c;
+        if (stream) printf("%9.3f %6.0f %c\n", t / 1e6, bank.frequency(i), c);
+      }
+    }
+  }
+  double wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall).count();
+
+  for (size_t i = 0; i < chans.size(); i++) {
+    std::string &text = chans[i].text;
+    while (!text.empty() && text.back() == ' ') text.pop_back();
+    if (text.empty()) continue;
+    printf("%6.0f Hz %3d wpm %3.0f dB  %s\n", bank.frequency(i), chans[i].wpm, bank.snr(i), text.c_str());
+  }
+
+  double audio_s = (double)audio / bc.rate;
+  fprintf(stderr, "%zu channels, %.1f s of audio in %.3f s (%.0fx real time)\n",
+          bank.channels(), audio_s, wall_s, wall_s > 0 ? audio_s / wall_s : 0.0);
+  return 0;
+}
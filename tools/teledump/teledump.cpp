@@ -0,0 +1,59 @@
+/****************************************
+  teledump - decode the CW Trainer's binary serial telemetry.
+
+  Reads the stream from a file, a serial device or stdin and prints one
+  line per event, or CSV with --csv. Reading a device straight from the
+  trainer needs the port set up first, e.g.
+    stty -F /dev/ttyACM0 250000 raw && teledump /dev/ttyACM0
+  The native runners write the same stream with --raw:
+    build/cw-trainer-sim --trainee --raw | build/teledump --csv > run.csv
+
+  Usage: teledump [--csv] [FILE]
+  The frame format is in cw-trainer/TeleProto.h, the CSV columns are
+  listed above tele_csv() in native/tele_parser.cpp.
+*****************************************/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "tele_parser.h"
+
+int main(int argc, char **argv)
+{
+  const char *in_file = NULL;
+  bool csv = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (!strcmp(argv[i], "--csv")) {
+      csv = true;
+    } else if (argv[i][0] != '-' && !in_file) {
+      in_file = argv[i];
+    } else {
+      fprintf(stderr, "Usage: %s [--csv] [FILE]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  FILE *f = in_file ? fopen(in_file, "rb") : stdin;
+  if (!f) {
+    perror(in_file);
+    return 1;
+  }
+  // A live serial port is read as it arrives, so flush every line
+  bool live = in_file && !strncmp(in_file, "/dev/", 5);
+
+  TeleParser parser([&](const TeleEvent &ev) {
+    puts(csv ? tele_csv(ev).c_str() : tele_log(ev).c_str());
+    if (live) fflush(stdout);
+  });
+  if (csv) puts(tele_csv_header());
+
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, live ? 1 : sizeof(buf), f)) > 0) parser.feed(buf, n);
+  if (f != stdin) fclose(f);
+
+  fprintf(stderr, "%lu frames, %lu events dropped by the sketch, %lu bad bytes\n",
+          parser.frames(), parser.dropped(), parser.badBytes());
+  return 0;
+}